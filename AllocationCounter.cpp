@@ -0,0 +1,266 @@
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#ifdef GAME_COUNT_ALLOCATIONS
+
+static std::atomic<std::size_t> allocationCount{ 0 };
+static std::atomic<std::size_t> deallocationCount{ 0 };
+
+// Tags active on this thread, outermost first; deeper tags are counted but not recorded
+static const int MAX_TAG_DEPTH = 16;
+static thread_local const char* tagStack[MAX_TAG_DEPTH];
+static thread_local int tagDepth = 0;
+static thread_local bool allocationsForbidden = false;
+static const char UNTAGGED[] = "untagged";
+
+// Totals per (phase, call site). Entries are only ever appended, and published by bumping siteCount
+// after they are filled in, so the allocation path reads them without a lock.
+struct AllocationSite {
+    const char* phase;
+    const char* site;
+    std::atomic<std::size_t> count;
+    std::atomic<std::size_t> bytes;
+};
+
+static const int MAX_SITES = 256;
+static AllocationSite sites[MAX_SITES];
+static std::atomic<int> siteCount{ 0 };
+static std::atomic_flag siteLock = ATOMIC_FLAG_INIT;
+static std::atomic<std::size_t> unrecordedCount{ 0 };    // Allocations after the table filled up
+
+static AllocationSite* findSite(const char* phase, const char* site) {
+    int count = siteCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        if (sites[i].phase == phase && sites[i].site == site) {
+            return &sites[i];
+        }
+    }
+
+    // Not seen yet - append it, checking again in case another thread just did
+    while (siteLock.test_and_set(std::memory_order_acquire)) {
+    }
+    AllocationSite* entry = nullptr;
+    count = siteCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count && !entry; ++i) {
+        if (sites[i].phase == phase && sites[i].site == site) {
+            entry = &sites[i];
+        }
+    }
+    if (!entry && count < MAX_SITES) {
+        entry = &sites[count];
+        entry->phase = phase;
+        entry->site = site;
+        siteCount.store(count + 1, std::memory_order_release);
+    }
+    siteLock.clear(std::memory_order_release);
+    return entry;
+}
+
+// Count an allocation against this thread's current tags
+static void account(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    int depth = std::min(tagDepth, MAX_TAG_DEPTH);
+    const char* phase = depth > 0 ? tagStack[0] : UNTAGGED;
+    const char* site = depth > 0 ? tagStack[depth - 1] : UNTAGGED;
+
+    if (allocationsForbidden) {
+        // stdio and abort don't come back through operator new
+        allocationsForbidden = false;
+        std::fprintf(stderr, "Allocation of %zu bytes in a steady-state tick (phase %s, call site %s)\n", size, phase, site);
+        std::abort();
+    }
+
+    if (AllocationSite* entry = findSite(phase, site)) {
+        entry->count.fetch_add(1, std::memory_order_relaxed);
+        entry->bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    else {
+        unrecordedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Counting replacement for the global operator new
+// The array and nothrow forms call this one by default, so they are counted too
+void* operator new(std::size_t size) {
+    account(size);
+
+    if (size == 0) {
+        size = 1;
+    }
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        deallocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+// Over-aligned allocations (std::pmr pools use these) bypass the scalar form, so count them separately
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    account(size);
+
+    std::size_t align = static_cast<std::size_t>(alignment);
+    size = (size + align - 1) / align * align;
+    if (size == 0) {
+        size = align;
+    }
+#ifdef _MSC_VER
+    void* ptr = _aligned_malloc(size, align);
+#else
+    void* ptr = std::aligned_alloc(align, size);
+#endif
+    if (ptr) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    if (ptr) {
+        deallocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    operator delete(ptr, alignment);
+}
+
+std::size_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void pushAllocationTag(const char* name) {
+    if (tagDepth < MAX_TAG_DEPTH) {
+        tagStack[tagDepth] = name;
+    }
+    ++tagDepth;
+}
+
+void popAllocationTag() {
+    --tagDepth;
+}
+
+void setAllocationsForbidden(bool forbidden) {
+    allocationsForbidden = forbidden;
+}
+
+AllocationContext getAllocationContext() {
+    int depth = std::min(tagDepth, MAX_TAG_DEPTH);
+    AllocationContext context;
+    context.phase = depth > 0 ? tagStack[0] : nullptr;
+    context.site = depth > 1 ? tagStack[depth - 1] : nullptr;
+    context.forbidden = allocationsForbidden;
+    return context;
+}
+
+// Constructor
+// The captured tags go on top of this thread's own; on a worker the stack is empty, so they
+// become its phase and call site
+AllocationContextScope::AllocationContextScope(const AllocationContext& context)
+    : depth(tagDepth), forbidden(allocationsForbidden) {
+    if (context.phase) {
+        pushAllocationTag(context.phase);
+    }
+    if (context.site) {
+        pushAllocationTag(context.site);
+    }
+    allocationsForbidden = context.forbidden;
+}
+
+// Destructor
+AllocationContextScope::~AllocationContextScope() {
+    tagDepth = depth;
+    allocationsForbidden = forbidden;
+}
+
+// Snapshot the table first, so the report's own allocations don't show up in it
+void printAllocationReport(std::ostream& os) {
+    struct Line {
+        const char* phase;
+        const char* site;
+        std::size_t count;
+        std::size_t bytes;
+    };
+    Line lines[MAX_SITES];
+    int count = siteCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        lines[i] = Line{ sites[i].phase, sites[i].site, sites[i].count.load(), sites[i].bytes.load() };
+    }
+    std::size_t allocations = allocationCount.load();
+    std::size_t deallocations = deallocationCount.load();
+    std::size_t unrecorded = unrecordedCount.load();
+
+    std::sort(lines, lines + count, [](const Line& a, const Line& b) { return a.bytes > b.bytes; });
+
+    // Phase totals, in order of first appearance in the sorted list
+    std::vector<Line> phases;
+    for (int i = 0; i < count; ++i) {
+        auto phase = std::find_if(phases.begin(), phases.end(), [&](const Line& line) { return line.phase == lines[i].phase; });
+        if (phase == phases.end()) {
+            phases.push_back(Line{ lines[i].phase, nullptr, lines[i].count, lines[i].bytes });
+        }
+        else {
+            phase->count += lines[i].count;
+            phase->bytes += lines[i].bytes;
+        }
+    }
+
+    os << "Allocations: " << allocations << ", frees: " << deallocations << std::endl;
+    os << "By phase:" << std::endl;
+    for (const auto& phase : phases) {
+        os << "  " << phase.phase << ": " << phase.count << " allocations, " << phase.bytes << " bytes" << std::endl;
+    }
+    os << "By call site:" << std::endl;
+    for (int i = 0; i < count; ++i) {
+        os << "  " << lines[i].phase << " / " << lines[i].site << ": " << lines[i].count << " allocations, "
+            << lines[i].bytes << " bytes" << std::endl;
+    }
+    if (unrecorded > 0) {
+        os << "  (" << unrecorded << " allocations from further call sites not broken down)" << std::endl;
+    }
+}
+
+#else
+
+std::size_t getAllocationCount() {
+    return 0;
+}
+
+void pushAllocationTag(const char*) {}
+void popAllocationTag() {}
+void setAllocationsForbidden(bool) {}
+
+AllocationContext getAllocationContext() {
+    return AllocationContext();
+}
+
+void printAllocationReport(std::ostream& os) {
+    os << "Allocation accounting needs a build with GAME_COUNT_ALLOCATIONS defined" << std::endl;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <ostream>
+
+// Define GAME_COUNT_ALLOCATIONS to replace the global operator new with a counting one
+#ifdef GAME_COUNT_ALLOCATIONS
+const bool ALLOCATION_COUNTING = true;
+#else
+const bool ALLOCATION_COUNTING = false;
+#endif
+
+// Number of global operator new calls so far (always 0 when counting is disabled)
+std::size_t getAllocationCount();
+
+// Allocation tags are kept per thread and nest. Every allocation is accounted to a phase,
+// the outermost tag, and a call site, the innermost one.
+void pushAllocationTag(const char* name);
+void popAllocationTag();
+
+// Tags allocations made by this thread while it is alive; name must be a string literal.
+// Compiles to nothing unless counting is enabled.
+class AllocationTag {
+public:
+    // Constructors - tied to one block, so it cannot be copied or moved
+#ifdef GAME_COUNT_ALLOCATIONS
+    explicit AllocationTag(const char* name) { pushAllocationTag(name); }
+    ~AllocationTag() { popAllocationTag(); }
+#else
+    explicit AllocationTag(const char*) {}
+    ~AllocationTag() {}
+#endif
+    AllocationTag(const AllocationTag& other) = delete;
+    AllocationTag(AllocationTag&& other) = delete;
+
+    // Assignment operator
+    AllocationTag& operator=(const AllocationTag& other) = delete;
+    AllocationTag& operator=(AllocationTag&& other) = delete;
+};
+
+// While set, any allocation on this thread prints its phase and call site and aborts the run
+void setAllocationsForbidden(bool forbidden);
+
+// What this thread accounts its allocations to: phase, call site and whether they are forbidden.
+// Work handed to another thread takes it along (AllocationContextScope), so a job run on a worker
+// is counted and checked like the code that scheduled it.
+struct AllocationContext {
+    const char* phase = nullptr;
+    const char* site = nullptr;
+    bool forbidden = false;
+};
+
+AllocationContext getAllocationContext();
+
+// Puts a captured context in place on this thread while it is alive, then restores the thread's own.
+// Compiles to nothing unless counting is enabled.
+class AllocationContextScope {
+private:
+#ifdef GAME_COUNT_ALLOCATIONS
+    int depth;
+    bool forbidden;
+#endif
+
+public:
+    // Constructors - tied to one block, so it cannot be copied or moved
+#ifdef GAME_COUNT_ALLOCATIONS
+    explicit AllocationContextScope(const AllocationContext& context);
+    ~AllocationContextScope();
+#else
+    explicit AllocationContextScope(const AllocationContext&) {}
+    ~AllocationContextScope() {}
+#endif
+    AllocationContextScope(const AllocationContextScope& other) = delete;
+    AllocationContextScope(AllocationContextScope&& other) = delete;
+
+    // Assignment operator
+    AllocationContextScope& operator=(const AllocationContextScope& other) = delete;
+    AllocationContextScope& operator=(AllocationContextScope&& other) = delete;
+};
+
+// Allocation counts and bytes by phase and by call site, largest first
+void printAllocationReport(std::ostream& os);
+
+#endif // ALLOCATION_COUNTER_H
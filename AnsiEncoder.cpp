@@ -0,0 +1,563 @@
+#include "AnsiEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+
+static const char CLEAR_SCREEN[] = "\x1b[0m\x1b[?25l\x1b[2J";
+
+// Colours of the rich style in console attribute order (Windows Terminal's default scheme)
+static const std::uint8_t RICH_PALETTE[16][3] = {
+    { 12, 12, 12 }, { 0, 55, 218 }, { 19, 161, 14 }, { 58, 150, 221 },
+    { 197, 15, 31 }, { 136, 23, 152 }, { 193, 156, 0 }, { 204, 204, 204 },
+    { 118, 118, 118 }, { 59, 120, 255 }, { 22, 198, 12 }, { 97, 214, 214 },
+    { 231, 72, 86 }, { 180, 0, 158 }, { 249, 241, 165 }, { 242, 242, 242 }
+};
+
+// Glyphs the rich style replaces: bunkers and the ship's wings become blocks, lines become box drawing
+static const std::pair<char, const char*> RICH_GLYPHS[] = {
+    { '=', "\xE2\x96\x88" },    // Full block
+    { '#', "\xE2\x96\x93" },    // Dark shade
+    { '|', "\xE2\x94\x82" },    // Box drawings light vertical
+    { '-', "\xE2\x94\x80" },    // Box drawings light horizontal
+    { '.', "\xC2\xB7" },        // Middle dot
+};
+
+static AnsiSequence makeSequence(std::string_view text) {
+    AnsiSequence sequence = {};
+    sequence.length = static_cast<std::uint8_t>(text.size());
+    std::memcpy(sequence.bytes, text.data(), text.size());
+    return sequence;
+}
+
+static void append(std::string& out, const AnsiSequence& sequence) {
+    out.append(sequence.bytes, sequence.length);
+}
+
+// Windows puts blue in bit 0 and red in bit 2, ANSI the other way round
+static int ansiColorCode(int color) {
+    int ansi = ((color & FOREGROUND_RED) ? 1 : 0) | ((color & FOREGROUND_GREEN) ? 2 : 0) | ((color & FOREGROUND_BLUE) ? 4 : 0);
+    return ((color & FOREGROUND_INTENSITY) ? 90 : 30) + ansi;
+}
+
+const AnsiStyle& plainAnsiStyle() {
+    static const AnsiStyle style = [] {
+        AnsiStyle built = {};
+        for (int color = 0; color < 16; ++color) {
+            built.colors[color] = makeSequence("\x1b[" + std::to_string(ansiColorCode(color)) + "m");
+        }
+        for (int glyph = 0; glyph < 256; ++glyph) {
+            char c = static_cast<char>(glyph);
+            built.glyphs[glyph] = makeSequence(std::string_view(&c, 1));
+        }
+        return built;
+    }();
+    return style;
+}
+
+const AnsiStyle& richAnsiStyle() {
+    static const AnsiStyle style = [] {
+        AnsiStyle built = plainAnsiStyle();
+        for (int color = 0; color < 16; ++color) {
+            const std::uint8_t* rgb = RICH_PALETTE[color];
+            built.colors[color] = makeSequence("\x1b[38;2;" + std::to_string(rgb[0]) + ";" + std::to_string(rgb[1]) + ";" +
+                std::to_string(rgb[2]) + "m");
+        }
+        for (const auto& [glyph, utf8] : RICH_GLYPHS) {
+            built.glyphs[static_cast<unsigned char>(glyph)] = makeSequence(utf8);
+        }
+        return built;
+    }();
+    return style;
+}
+
+// Cursor movement, built once: an absolute move is a row prefix and a column suffix; relative
+// moves are single sequences, indexed by distance. One step back is a backspace and one row up
+// or down is a reverse or plain index (ESC M, ESC D), which keep the column; an index only
+// scrolls from the edge of the screen, and moves here never leave the field.
+struct CursorMoves {
+    AnsiSequence rows[POLE_ROWS];       // ESC [ row ;
+    AnsiSequence columns[POLE_COLS];    // column H
+    AnsiSequence up[POLE_ROWS];         // ESC [ n A
+    AnsiSequence down[POLE_ROWS];       // ESC [ n B
+    AnsiSequence forward[POLE_COLS];    // ESC [ n C
+    AnsiSequence back[POLE_COLS];       // ESC [ n D
+};
+
+static AnsiSequence relativeMove(int distance, char command) {
+    if (distance == 0) {
+        return makeSequence("");
+    }
+    return makeSequence("\x1b[" + (distance == 1 ? std::string() : std::to_string(distance)) + command);
+}
+
+static const CursorMoves& cursorMoves() {
+    static const CursorMoves moves = [] {
+        CursorMoves built = {};
+        for (int y = 0; y < POLE_ROWS; ++y) {
+            built.rows[y] = makeSequence("\x1b[" + std::to_string(y + 1) + ";");
+            built.up[y] = relativeMove(y, 'A');
+            built.down[y] = relativeMove(y, 'B');
+        }
+        for (int x = 0; x < POLE_COLS; ++x) {
+            built.columns[x] = makeSequence(std::to_string(x + 1) + "H");
+            built.forward[x] = relativeMove(x, 'C');
+            built.back[x] = relativeMove(x, 'D');
+        }
+        built.up[1] = makeSequence("\x1b" "M");
+        built.down[1] = makeSequence("\x1b" "D");
+        built.back[1] = makeSequence("\b");
+        return built;
+    }();
+    return moves;
+}
+
+// Bytes of the shortest move to a zero-based cell, and whether it is relative
+static int moveCost(const TerminalState& state, int x, int y, bool* relative = nullptr) {
+    const CursorMoves& moves = cursorMoves();
+    int cost = moves.rows[y].length + moves.columns[x].length;
+    bool useRelative = false;
+    if (state.y >= 0 && state.x >= 0 && state.x < POLE_COLS) {
+        const AnsiSequence& vertical = y < state.y ? moves.up[state.y - y] : moves.down[y - state.y];
+        const AnsiSequence& horizontal = x < state.x ? moves.back[state.x - x] : moves.forward[x - state.x];
+        if (vertical.length + horizontal.length < cost) {
+            cost = vertical.length + horizontal.length;
+            useRelative = true;
+        }
+    }
+    if (relative) {
+        *relative = useRelative;
+    }
+    return cost;
+}
+
+// Move the cursor to a zero-based cell with whichever of an absolute or a relative move is shorter.
+// The cursor is never left past the last column, where terminals disagree about where it is.
+static void moveCursor(std::string& out, TerminalState& state, int x, int y) {
+    if (state.x == x && state.y == y) {
+        return;
+    }
+    const CursorMoves& moves = cursorMoves();
+    bool relative;
+    moveCost(state, x, y, &relative);
+    if (relative) {
+        append(out, y < state.y ? moves.up[state.y - y] : moves.down[y - state.y]);
+        append(out, x < state.x ? moves.back[state.x - x] : moves.forward[x - state.x]);
+    }
+    else {
+        append(out, moves.rows[y]);
+        append(out, moves.columns[x]);
+    }
+    state.x = x;
+    state.y = y;
+}
+
+// Append a cell, switching colour only when a visible glyph needs another one
+static void appendCell(std::string& out, const Cell& cell, TerminalState& state, const AnsiStyle& style) {
+    int color = static_cast<int>(cell.color) & 0x0F;
+    if (color != state.color && cell.glyph != ' ') {
+        append(out, style.colors[color]);
+        state.color = color;
+    }
+    append(out, style.glyphs[static_cast<unsigned char>(cell.glyph)]);
+    ++state.x;
+}
+
+static bool sameCell(const Cell& a, const Cell& b) {
+    return a.glyph == b.glyph && (a.color == b.color || a.glyph == ' ');
+}
+
+// Bit in a row's change mask for cells that changed to a blank; bits 0 to 15 are colours
+static const std::uint32_t BLANK_CHANGED = 1u << 16;
+
+static int colorOf(const Cell& cell) {
+    return static_cast<int>(cell.color) & 0x0F;
+}
+
+// Bytes appendCell would write for a run of cells, starting from a colour
+static int cellsCost(const Cell* cells, int count, int color, const AnsiStyle& style) {
+    int cost = 0;
+    for (int i = 0; i < count; ++i) {
+        if (cells[i].glyph != ' ' && colorOf(cells[i]) != color) {
+            color = colorOf(cells[i]);
+            cost += style.colors[color].length;
+        }
+        cost += style.glyphs[static_cast<unsigned char>(cells[i].glyph)].length;
+    }
+    return cost;
+}
+
+// Changed cells are written in passes, row by row. A pass for one colour writes the changed
+// cells of that colour and any changed blanks it comes across; a pass for every colour (-1)
+// writes all changed cells. Cells between two that are due are written again when that takes
+// fewer bytes than moving the cursor over them.
+static void encodePass(const Cell* previous, const Cell* current, const std::uint32_t* rowChanges, int color,
+    std::bitset<POLE_COLS * POLE_ROWS>& written, TerminalState& state, std::string& out, const AnsiStyle& style) {
+    static const Cell BLANK = { ' ', WHITE };
+    const CursorMoves& moves = cursorMoves();
+    std::uint32_t passBits = color >= 0 ? (1u << color) | BLANK_CHANGED : ~0u;
+
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        if (!(rowChanges[y] & passBits)) {
+            continue;
+        }
+        const Cell* row = current + y * POLE_COLS;
+        const Cell* oldRow = previous ? previous + y * POLE_COLS : nullptr;
+        std::size_t rowStart = static_cast<std::size_t>(y) * POLE_COLS;
+
+        auto due = [&](int x) {
+            return !written[rowStart + x] && !sameCell(oldRow ? oldRow[x] : BLANK, row[x]) &&
+                (color < 0 || row[x].glyph == ' ' || colorOf(row[x]) == color);
+        };
+        auto writeCell = [&](int x) {
+            appendCell(out, row[x], state, style);
+            written[rowStart + x] = true;
+        };
+
+        int x = 0;
+        while (x < POLE_COLS) {
+            if (!due(x)) {
+                ++x;
+                continue;
+            }
+            moveCursor(out, state, x, y);
+            writeCell(x);
+            ++x;
+
+            // Carry on through the row while the next due cell is cheaper to reach by rewriting
+            while (x < POLE_COLS) {
+                int next = x;
+                while (next < POLE_COLS && !due(next) && (color < 0 || row[next].glyph == ' ' || colorOf(row[next]) == color)) {
+                    ++next;
+                }
+                if (next == POLE_COLS || !due(next) || cellsCost(row + x, next - x, state.color, style) > moves.forward[next - x].length) {
+                    break;
+                }
+                for (; x <= next; ++x) {
+                    writeCell(x);
+                }
+            }
+        }
+    }
+}
+
+// Most runs the third order considers; frames with more are mostly keyframes and full-screen
+// changes, where the passes already do well
+static const int MAX_RUNS = 512;
+
+// A stretch of a row written in one go: due cells whose glyphs share one colour, with blanks
+// and any cells between them that are cheaper to rewrite than to skip
+struct CellRun {
+    std::int16_t x;
+    std::int16_t y;
+    std::int16_t length;
+    std::int16_t color;     // -1 for a run of blanks
+};
+
+// Runs are written nearest first, counting the colour switch as part of the distance, so the
+// cursor hops between neighbouring changes and a colour is kept for as long as it is close by.
+// Returns false, having written nothing, when the frame has more than MAX_RUNS runs.
+static bool encodeRuns(const Cell* previous, const Cell* current, TerminalState& state, std::string& out, const AnsiStyle& style) {
+    static const Cell BLANK = { ' ', WHITE };
+    const CursorMoves& moves = cursorMoves();
+    CellRun runs[MAX_RUNS];
+    int runCount = 0;
+
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        const Cell* row = current + y * POLE_COLS;
+        const Cell* oldRow = previous ? previous + y * POLE_COLS : nullptr;
+        auto due = [&](int x) {
+            return !sameCell(oldRow ? oldRow[x] : BLANK, row[x]);
+        };
+        // -1 for a blank, which fits a run of any colour
+        auto colorNeeded = [&](int x) {
+            return row[x].glyph == ' ' ? -1 : colorOf(row[x]);
+        };
+
+        int x = 0;
+        while (x < POLE_COLS) {
+            if (!due(x)) {
+                ++x;
+                continue;
+            }
+            if (runCount == MAX_RUNS) {
+                return false;
+            }
+            CellRun& run = runs[runCount++];
+            run.x = static_cast<std::int16_t>(x);
+            run.y = static_cast<std::int16_t>(y);
+            run.color = static_cast<std::int16_t>(colorNeeded(x));
+            int end = ++x;
+
+            // Take in the next due cell while it fits the run's colour and the cells up to it
+            // are cheaper to rewrite than to skip
+            while (x < POLE_COLS) {
+                int next = x;
+                int gapCost = 0;
+                while (next < POLE_COLS && !due(next) && (colorNeeded(next) < 0 || colorNeeded(next) == run.color)) {
+                    gapCost += style.glyphs[static_cast<unsigned char>(row[next].glyph)].length;
+                    ++next;
+                }
+                if (next == POLE_COLS || !due(next) || (next > x && gapCost > moves.forward[next - x].length)) {
+                    break;
+                }
+                int color = colorNeeded(next);
+                if (color >= 0 && run.color >= 0 && color != run.color) {
+                    break;
+                }
+                if (color >= 0) {
+                    run.color = static_cast<std::int16_t>(color);
+                }
+                x = end = next + 1;
+            }
+            run.length = static_cast<std::int16_t>(end - run.x);
+            x = end;
+        }
+    }
+
+    std::bitset<MAX_RUNS> done;
+    for (int written = 0; written < runCount; ++written) {
+        int best = -1;
+        int bestCost = 0;
+        for (int i = 0; i < runCount; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            const CellRun& run = runs[i];
+            int cost = moveCost(state, run.x, run.y);
+            if (run.color >= 0 && run.color != state.color) {
+                cost += style.colors[run.color].length;
+            }
+            if (best < 0 || cost < bestCost) {
+                best = i;
+                bestCost = cost;
+            }
+        }
+        done[best] = true;
+        const CellRun& run = runs[best];
+        moveCursor(out, state, run.x, run.y);
+        const Cell* row = current + run.y * POLE_COLS;
+        for (int i = 0; i < run.length; ++i) {
+            appendCell(out, row[run.x + i], state, style);
+        }
+    }
+    return true;
+}
+
+// Keep the shorter of the candidate encoded at out[start, end) and the one after it, and the
+// terminal state it leaves
+static void keepShorter(std::string& out, std::size_t start, std::size_t end, TerminalState& kept, const TerminalState& candidate) {
+    if (out.size() - end < end - start) {
+        out.erase(start, end - start);
+        kept = candidate;
+    }
+    else {
+        out.resize(end);
+    }
+}
+
+// Three orders are encoded and the shortest one kept: all changes row by row, which needs the
+// fewest cursor moves; one pass per colour, which switches colour once per colour that changed
+// instead of once per run; and nearest run first, which wins when the changes are scattered
+// bullets and sprites of a few colours. Colour switches are what the orders trade against
+// cursor moves; the rich style spends 17 to 19 bytes on one.
+void encodeCells(const Cell* previous, const Cell* current, std::string& out, TerminalState& terminal, const AnsiStyle& style) {
+    static const Cell BLANK = { ' ', WHITE };
+
+    // Which colours (and whether blanks) changed in each row, and the order colours first appear in
+    std::uint32_t rowChanges[POLE_ROWS] = {};
+    int passColors[16];
+    int passes = 0;
+    std::uint32_t seen = 0;
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        const Cell* row = current + y * POLE_COLS;
+        const Cell* oldRow = previous ? previous + y * POLE_COLS : nullptr;
+        for (int x = 0; x < POLE_COLS; ++x) {
+            if (sameCell(oldRow ? oldRow[x] : BLANK, row[x])) {
+                continue;
+            }
+            std::uint32_t bit = row[x].glyph == ' ' ? BLANK_CHANGED : 1u << colorOf(row[x]);
+            rowChanges[y] |= bit;
+            if (bit != BLANK_CHANGED && !(seen & bit)) {
+                seen |= bit;
+                passColors[passes++] = colorOf(row[x]);
+            }
+        }
+    }
+
+    std::size_t start = out.size();
+    std::bitset<POLE_COLS * POLE_ROWS> written;
+    TerminalState kept = terminal;
+    encodePass(previous, current, rowChanges, -1, written, kept, out, style);
+    if (out.size() == start) {
+        return;
+    }
+
+    if (passes >= 2) {
+        std::size_t end = out.size();
+        written.reset();
+        TerminalState state = terminal;
+        for (int pass = 0; pass < passes; ++pass) {
+            encodePass(previous, current, rowChanges, passColors[pass], written, state, out, style);
+        }
+        keepShorter(out, start, end, kept, state);
+    }
+
+    std::size_t end = out.size();
+    TerminalState state = terminal;
+    if (encodeRuns(previous, current, state, out, style)) {
+        keepShorter(out, start, end, kept, state);
+    }
+    terminal = kept;
+}
+
+// Encode a full frame
+void encodeKeyframe(const Frame& frame, std::string& out, TerminalState& terminal, const AnsiStyle& style) {
+    out += CLEAR_SCREEN;
+    terminal = TerminalState();
+    encodeCells(nullptr, frame.data(), out, terminal, style);
+}
+
+// Encode the changed cells
+void encodeDelta(const Frame& previous, const Frame& current, std::string& out, TerminalState& terminal, const AnsiStyle& style) {
+    encodeCells(previous.data(), current.data(), out, terminal, style);
+}
+
+// Encode the moves to another terminal state
+void encodeTerminalState(const TerminalState& target, std::string& out, TerminalState& terminal, const AnsiStyle& style) {
+    if (target.x >= 0 && target.x < POLE_COLS && target.y >= 0) {
+        moveCursor(out, terminal, target.x, target.y);
+    }
+    else {
+        // Past the last column or unknown; the stream moves the cursor absolutely from there
+        terminal.x = target.x;
+        terminal.y = target.y;
+    }
+    if (target.color >= 0 && target.color != terminal.color) {
+        append(out, style.colors[target.color]);
+    }
+    terminal.color = target.color;
+}
+
+// ANSI foreground code back to console attribute bits
+static COLORS colorOfCode(int code) {
+    int intensity = code >= 90 ? FOREGROUND_INTENSITY : 0;
+    int ansi = code - (code >= 90 ? 90 : 30);
+    int color = intensity | ((ansi & 1) ? FOREGROUND_RED : 0) | ((ansi & 2) ? FOREGROUND_GREEN : 0) | ((ansi & 4) ? FOREGROUND_BLUE : 0);
+    return static_cast<COLORS>(color);
+}
+
+// 24-bit colour back to the nearest of the 16
+static COLORS colorOfRgb(int red, int green, int blue) {
+    int best = 0;
+    int bestDistance = -1;
+    for (int color = 0; color < 16; ++color) {
+        int dr = red - RICH_PALETTE[color][0];
+        int dg = green - RICH_PALETTE[color][1];
+        int db = blue - RICH_PALETTE[color][2];
+        int distance = dr * dr + dg * dg + db * db;
+        if (bestDistance < 0 || distance < bestDistance) {
+            best = color;
+            bestDistance = distance;
+        }
+    }
+    return static_cast<COLORS>(best);
+}
+
+// A UTF-8 glyph of the rich style back to the character it stands for
+static char glyphOfUtf8(std::string_view bytes) {
+    for (const auto& [glyph, utf8] : RICH_GLYPHS) {
+        if (bytes == utf8) {
+            return glyph;
+        }
+    }
+    return '?';
+}
+
+// Decode one message
+void decodeAnsi(std::string_view message, Frame& frame, TerminalState& terminal) {
+    int x = std::max(terminal.x, 0);
+    int y = std::max(terminal.y, 0);
+    COLORS color = terminal.color >= 0 ? static_cast<COLORS>(terminal.color) : LIGHT_GREY;
+
+    std::size_t i = 0;
+    while (i < message.size()) {
+        unsigned char byte = static_cast<unsigned char>(message[i]);
+        if (byte >= 0x80) {
+            std::size_t length = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+            frame.put(x++, y, glyphOfUtf8(message.substr(i, length)), color);
+            i += length;
+            continue;
+        }
+        if (byte == '\b') {
+            x = std::max(x - 1, 0);
+            ++i;
+            continue;
+        }
+        if (byte != '\x1b') {
+            frame.put(x++, y, message[i++], color);
+            continue;
+        }
+
+        // Index and reverse index - ESC D, ESC M
+        if (i + 1 < message.size() && (message[i + 1] == 'D' || message[i + 1] == 'M')) {
+            y += message[i + 1] == 'D' ? 1 : -1;
+            i += 2;
+            continue;
+        }
+
+        // Control sequence - ESC [ parameters final-letter
+        int parameters[5] = { 0, 0, 0, 0, 0 };
+        int count = 0;
+        i += 2;
+        while (i < message.size() && !std::isalpha(static_cast<unsigned char>(message[i]))) {
+            if (message[i] == ';') {
+                count = std::min(count + 1, 4);
+            }
+            else if (std::isdigit(static_cast<unsigned char>(message[i]))) {
+                parameters[count] = parameters[count] * 10 + (message[i] - '0');
+            }
+            ++i;
+        }
+        if (i == message.size()) {
+            break;
+        }
+
+        char command = message[i++];
+        if (command == 'H') {
+            y = std::max(parameters[0], 1) - 1;
+            x = std::max(parameters[1], 1) - 1;
+        }
+        else if (command == 'A') {
+            y -= std::max(parameters[0], 1);
+        }
+        else if (command == 'B') {
+            y += std::max(parameters[0], 1);
+        }
+        else if (command == 'C') {
+            x += std::max(parameters[0], 1);
+        }
+        else if (command == 'D') {
+            x -= std::max(parameters[0], 1);
+        }
+        else if (command == 'J' && parameters[0] == 2) {
+            frame.clear();
+        }
+        else if (command == 'm') {
+            int code = parameters[0];
+            if (code == 38 && parameters[1] == 2) {
+                color = colorOfRgb(parameters[2], parameters[3], parameters[4]);
+            }
+            else {
+                color = (code >= 30 && code <= 37) || (code >= 90 && code <= 97) ? colorOfCode(code) : LIGHT_GREY;
+            }
+        }
+    }
+
+    terminal.x = x;
+    terminal.y = y;
+    terminal.color = static_cast<int>(color);
+}
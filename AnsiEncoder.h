@@ -0,0 +1,51 @@
+#ifndef ANSI_ENCODER_H
+#define ANSI_ENCODER_H
+
+#include "Frame.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Encoding of frames as ANSI escape sequences for terminals on the other end of a stream.
+// A delta starts where the previous message left the cursor and colour, which the sender tracks
+// in a TerminalState. A keyframe starts from an unknown state, so a receiver can begin at any
+// keyframe and a sender can drop deltas as long as it follows up with a keyframe.
+
+// A short escape sequence or glyph, stored inline so emitting it is a single copy
+struct AnsiSequence {
+    std::uint8_t length;
+    char bytes[23];
+};
+
+// How cells are spelled: the sequence that selects each of the 16 console colours and the bytes
+// sent for each glyph. Styles are built once; encoding a cell then only copies bytes.
+struct AnsiStyle {
+    AnsiSequence colors[16];
+    AnsiSequence glyphs[256];
+};
+
+// 16 ANSI colours and the glyphs as they are
+const AnsiStyle& plainAnsiStyle();
+
+// 24-bit colours and UTF-8 block and box-drawing glyphs for terminals that support them
+const AnsiStyle& richAnsiStyle();
+
+// Clear the terminal and draw the whole frame
+void encodeKeyframe(const Frame& frame, std::string& out, TerminalState& terminal, const AnsiStyle& style = plainAnsiStyle());
+
+// Draw only the cells that differ between previous and current
+void encodeDelta(const Frame& previous, const Frame& current, std::string& out, TerminalState& terminal,
+    const AnsiStyle& style = plainAnsiStyle());
+
+// The same on a bare grid of POLE_COLS x POLE_ROWS cells; a null previous is a cleared screen
+void encodeCells(const Cell* previous, const Cell* current, std::string& out, TerminalState& terminal, const AnsiStyle& style);
+
+// Move the cursor and set the colour to where another stream left them, so a receiver that
+// joined with a keyframe can follow that stream's deltas
+void encodeTerminalState(const TerminalState& target, std::string& out, TerminalState& terminal, const AnsiStyle& style);
+
+// Apply an encoded message to a frame, the way a terminal would, starting from and updating
+// the terminal's state; only understands the sequences the encoder produces, in either style
+void decodeAnsi(std::string_view message, Frame& frame, TerminalState& terminal);
+
+#endif // ANSI_ENCODER_H
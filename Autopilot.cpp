@@ -0,0 +1,82 @@
+#include "Autopilot.h"
+#include "Game.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// Within a tick the key is handled before bullets move, so a bullet t rows above the ship
+// lands on tick t, when the ship has made min(t, steps) of its moves
+bool Autopilot::isSafe(const Game& game, const Player& player, int direction, int steps) const {
+    if (player.getLeft() + direction * steps < 0 || player.getRight() + direction * steps >= POLE_COLS) {
+        return false;
+    }
+
+    for (const auto& bullet : game.getBullets()) {
+        if (bullet.getDirection() <= 0) {
+            continue;
+        }
+        int ticks = player.getTop() - bullet.getY();
+        if (ticks < 1 || ticks > LOOKAHEAD) {
+            continue;
+        }
+        int shift = direction * std::min(ticks, steps);
+        if (bullet.getX() >= player.getLeft() + shift && bullet.getX() <= player.getRight() + shift) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The player's ship
+int Autopilot::chooseKey(const Game& game) const {
+    return chooseKey(game, game.getPlayer());
+}
+
+// Dodge first, then line up and shoot
+int Autopilot::chooseKey(const Game& game, const Player& player) const {
+
+    // Get out of the way of anything about to land, by the shortest safe run
+    if (!isSafe(game, player, 0, 0)) {
+        for (int steps = 1; steps <= MAX_ESCAPE; ++steps) {
+            if (isSafe(game, player, -1, steps)) {
+                return 'a';
+            }
+            if (isSafe(game, player, 1, steps)) {
+                return 'd';
+            }
+        }
+        return -1;
+    }
+
+    // The lowest enemy is the most urgent one; ties go to the nearest
+    const Enemy* target = nullptr;
+    for (const auto& entity : game.getEnemies()) {
+        const Enemy& enemy = asEnemy(entity);
+        if (!target || enemy.getBottom() > target->getBottom() ||
+            (enemy.getBottom() == target->getBottom() &&
+                std::abs(enemy.getX() - player.getX()) < std::abs(target->getX() - player.getX()))) {
+            target = &enemy;
+        }
+    }
+    if (!target) {
+        return -1;
+    }
+
+    // Step towards the target column unless that walks into fire
+    int dx = target->getX() - player.getX();
+    if (dx != 0 && isSafe(game, player, dx < 0 ? -1 : 1, 1)) {
+        return dx < 0 ? 'a' : 'd';
+    }
+
+    // Fire while lined up, without flooding the screen
+    int shotsInFlight = 0;
+    for (const auto& bullet : game.getBullets()) {
+        if (bullet.getDirection() < 0) {
+            ++shotsInFlight;
+        }
+    }
+    if (std::abs(dx) <= 1 && shotsInFlight < MAX_SHOTS_IN_FLIGHT) {
+        return ' ';
+    }
+    return -1;
+}
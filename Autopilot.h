@@ -0,0 +1,43 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+class Game;
+class Player;
+
+// Deterministic bot that plays through the same key path as the keyboard.
+// Each tick it runs from enemy bullets about to reach the ship, taking the shortest
+// escape that stays clear, otherwise lines up under the lowest enemy and fires. It uses no randomness, so a seeded game
+// played by the autopilot always ends the same way.
+class Autopilot {
+private:
+    // Ticks ahead an enemy bullet counts as a threat
+    static const int LOOKAHEAD = 8;
+
+    // Furthest the ship will run to get out of the way
+    static const int MAX_ESCAPE = 8;
+
+    // Player bullets allowed in flight before holding fire
+    static const int MAX_SHOTS_IN_FLIGHT = 3;
+
+    // Check that moving steps columns in direction (one per tick, then holding still)
+    // keeps the ship clear of every enemy bullet landing within LOOKAHEAD ticks
+    bool isSafe(const Game& game, const Player& player, int direction, int steps) const;
+
+public:
+    // Constructors - no state, so the defaults are enough
+    Autopilot() = default;
+    Autopilot(const Autopilot& other) = default;
+    Autopilot(Autopilot&& other) noexcept = default;
+    ~Autopilot() = default;
+
+    // Assignment operator
+    Autopilot& operator=(const Autopilot& other) = default;
+    Autopilot& operator=(Autopilot&& other) noexcept = default;
+
+    // Pick the key to press this tick, or -1 for none - for the player's ship, or for the given
+    // one (the partner in a two-player game)
+    int chooseKey(const Game& game) const;
+    int chooseKey(const Game& game, const Player& player) const;
+};
+
+#endif // AUTOPILOT_H
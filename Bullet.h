@@ -3,7 +3,7 @@
 
 #include "GameObject.h"
 
-class Bullet : public GameObject {
+class Bullet final : public GameObject {
 private:
     int direction;  // -1 for up (player bullet), 1 for down (enemy bullet)
 
@@ -0,0 +1,127 @@
+#include "Bunkers.h"
+
+#include <bit>
+#include <string>
+#include <string_view>
+
+// Shape of a single bunker, top row first
+static const char* const BUNKER_SHAPE[BUNKER_HEIGHT] = {
+    "  ############  ",
+    " ############## ",
+    "################",
+    "#####      #####"
+};
+
+static const char BUNKER_SYMBOL = '=';
+static const COLORS BUNKER_COLOR = GREEN;
+
+// Constructor
+Bunkers::Bunkers() {
+    reset();
+}
+
+// Rebuild all bunkers intact
+void Bunkers::reset() {
+    for (auto& row : rows) {
+        row.fill(0);
+    }
+
+    // Spread the bunkers evenly across the field
+    int spacing = POLE_COLS / BUNKER_COUNT;
+    for (int bunker = 0; bunker < BUNKER_COUNT; ++bunker) {
+        int left = spacing * bunker + (spacing - BUNKER_WIDTH) / 2;
+        for (int row = 0; row < BUNKER_HEIGHT; ++row) {
+            for (int col = 0; col < BUNKER_WIDTH; ++col) {
+                if (BUNKER_SHAPE[row][col] != ' ') {
+                    mark(rows[row], left + col);
+                }
+            }
+        }
+    }
+}
+
+// Check whether a cell is solid
+bool Bunkers::contains(int x, int y) const {
+    int row = y - BUNKER_TOP;
+    if (row < 0 || row >= BUNKER_HEIGHT || x < 0 || x >= POLE_COLS) {
+        return false;
+    }
+    return (rows[row][x >> 6] >> (x & 63)) & 1;
+}
+
+// Clear every masked cell in a row
+void Bunkers::erode(int y, const Row& mask) {
+    int row = y - BUNKER_TOP;
+    if (row < 0 || row >= BUNKER_HEIGHT) {
+        return;
+    }
+    for (int word = 0; word < WORDS; ++word) {
+        rows[row][word] &= ~mask[word];
+    }
+}
+
+// Set the bit for a column in a row mask
+void Bunkers::mark(Row& row, int x) {
+    if (x >= 0 && x < POLE_COLS) {
+        row[x >> 6] |= std::uint64_t(1) << (x & 63);
+    }
+}
+
+// Test the bit for a column in a row mask
+bool Bunkers::marked(const Row& row, int x) {
+    return x >= 0 && x < POLE_COLS && (row[x >> 6] >> (x & 63) & 1) != 0;
+}
+
+// OR a sprite row into a row mask, splitting it across two words when it straddles a boundary
+void Bunkers::mark(Row& row, int left, std::uint64_t bits) {
+    // Drop whatever hangs off the left edge
+    if (left < 0) {
+        bits = -left < 64 ? bits >> -left : 0;
+        left = 0;
+    }
+    if (bits == 0 || left >= POLE_COLS) {
+        return;
+    }
+
+    int word = left >> 6;
+    int offset = left & 63;
+    row[word] |= bits << offset;
+    if (offset != 0 && word + 1 < WORDS) {
+        row[word + 1] |= bits >> (64 - offset);
+    }
+
+    // Keep bits past the last column clear
+    if (POLE_COLS % 64 != 0) {
+        row[WORDS - 1] &= (std::uint64_t(1) << (POLE_COLS % 64)) - 1;
+    }
+}
+
+// Render every run of solid cells as one piece of text
+// Empty words are skipped whole, and run edges are found with bit scans
+void Bunkers::render() const {
+    static const std::string solid(POLE_COLS, BUNKER_SYMBOL);
+
+    for (int row = 0; row < BUNKER_HEIGHT; ++row) {
+        int x = 0;
+        while (x < POLE_COLS) {
+            std::uint64_t bits = rows[row][x >> 6] >> (x & 63);
+            if (bits == 0) {
+                x = (x | 63) + 1;
+                continue;
+            }
+            x += std::countr_zero(bits);
+
+            // Extend the run across word boundaries
+            int start = x;
+            for (;;) {
+                int offset = x & 63;
+                int run = std::countr_zero(~(rows[row][x >> 6] >> offset));
+                x += run;
+                if (run < 64 - offset || x >= POLE_COLS) {
+                    break;
+                }
+            }
+            drawTextAtPosition(start, BUNKER_TOP + row, std::string_view(solid).substr(0, x - start), BUNKER_COLOR);
+        }
+    }
+}
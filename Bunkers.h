@@ -0,0 +1,58 @@
+#ifndef BUNKERS_H
+#define BUNKERS_H
+
+#include "ConsoleUtils.h"
+#include <array>
+#include <cstdint>
+
+// Bunker band, a few rows above the player
+const int BUNKER_TOP = POLE_ROWS - 13;
+const int BUNKER_HEIGHT = 4;
+const int BUNKER_COUNT = 4;
+const int BUNKER_WIDTH = 16;
+
+// Destructible shields between the player and the enemy formation.
+// Every bunker row is a packed bitmap with one bit per column, so a bullet
+// hit is a single bit test and erosion clears whole 64-column words at once.
+class Bunkers {
+public:
+    static const int WORDS = (POLE_COLS + 63) / 64;
+    using Row = std::array<std::uint64_t, WORDS>;
+
+private:
+    std::array<Row, BUNKER_HEIGHT> rows;
+
+public:
+    // Constructors - plain bitmap data, so the defaults are enough
+    Bunkers();
+    Bunkers(const Bunkers& other) = default;
+    Bunkers(Bunkers&& other) noexcept = default;
+    ~Bunkers() = default;
+
+    // Assignment operator
+    Bunkers& operator=(const Bunkers& other) = default;
+    Bunkers& operator=(Bunkers&& other) noexcept = default;
+
+    // Rebuild all bunkers intact
+    void reset();
+
+    // Check whether a cell is solid
+    bool contains(int x, int y) const;
+
+    // Clear every cell in row y whose bit is set in mask
+    void erode(int y, const Row& mask);
+
+    // Set the bit for column x in a row mask
+    static void mark(Row& row, int x);
+
+    // Check the bit for column x in a row mask
+    static bool marked(const Row& row, int x);
+
+    // OR a run of bits into a row mask, bit 0 landing on column left
+    static void mark(Row& row, int left, std::uint64_t bits);
+
+    // Draw the bunker rows straight from the bitmap
+    void render() const;
+};
+
+#endif // BUNKERS_H
@@ -1,4 +1,34 @@
 #include "ConsoleUtils.h"
+#include "Frame.h"
+#include "Sprite.h"
+
+// Frame being drawn on this thread, if any
+static thread_local Frame* renderTarget = nullptr;
+
+// Copy of the console for recording; the console is shared by all threads, and so is this
+static Frame* consoleMirror = nullptr;
+
+void setRenderTarget(Frame* frame) {
+    renderTarget = frame;
+}
+
+void setConsoleMirror(Frame* frame) {
+    consoleMirror = frame;
+}
+
+Frame* getConsoleMirror() {
+    return consoleMirror;
+}
+
+bool enableVirtualTerminal() {
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode;
+    if (!GetConsoleMode(hConsole, &mode) || !SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) {
+        return false;
+    }
+    SetConsoleOutputCP(CP_UTF8);
+    return true;
+}
 
 void setCursorPosition(int x, int y) {
     COORD coord;
@@ -26,6 +56,11 @@ void showCursor() {
 }
 
 void clearScreen() {
+    if (renderTarget) {
+        renderTarget->clear();
+        return;
+    }
+
     COORD coordScreen = { 0, 0 };
     DWORD cCharsWritten;
     CONSOLE_SCREEN_BUFFER_INFO csbi;
@@ -38,16 +73,59 @@ void clearScreen() {
     GetConsoleScreenBufferInfo(hConsole, &csbi);
     FillConsoleOutputAttribute(hConsole, csbi.wAttributes, dwConSize, coordScreen, &cCharsWritten);
     SetConsoleCursorPosition(hConsole, coordScreen);
+
+    if (consoleMirror) {
+        consoleMirror->clear();
+    }
 }
 
 void drawCharAtPosition(int x, int y, char symbol, COLORS color) {
+    if (renderTarget) {
+        renderTarget->put(x, y, symbol, color);
+        return;
+    }
+
     setCursorPosition(x, y);
     setColor(color);
     std::cout << symbol;
+
+    if (consoleMirror) {
+        consoleMirror->put(x, y, symbol, color);
+    }
 }
 
-void drawTextAtPosition(int x, int y, const std::string& text, COLORS color) {
+void drawTextAtPosition(int x, int y, std::string_view text, COLORS color) {
+    if (renderTarget) {
+        renderTarget->putText(x, y, text, color);
+        return;
+    }
+
     setCursorPosition(x, y);
     setColor(color);
     std::cout << text;
+
+    if (consoleMirror) {
+        consoleMirror->putText(x, y, text, color);
+    }
+}
+
+void drawSpriteAtPosition(int x, int y, const Sprite& sprite) {
+    if (renderTarget) {
+        renderTarget->blit(x, y, sprite);
+        return;
+    }
+
+    for (int row = 0; row < sprite.getHeight(); ++row) {
+        for (int col = 0; col < sprite.getWidth(); ++col) {
+            if ((sprite.getMask(row) >> col) & 1) {
+                setCursorPosition(x + col, y + row);
+                setColor(sprite.getColor(col, row));
+                std::cout << sprite.getGlyph(col, row);
+            }
+        }
+    }
+
+    if (consoleMirror) {
+        consoleMirror->blit(x, y, sprite);
+    }
 }
@@ -1,12 +1,11 @@
 #ifndef CONSOLE_UTILS_H
 #define CONSOLE_UTILS_H
 
+#include "Playfield.h"
 #include <windows.h>
 #include <iostream>
 #include <string>
-
-const int POLE_ROWS = 90;
-const int POLE_COLS = 180;
+#include <string_view>
 
 enum COLORS {
     BLACK = 0,
@@ -27,6 +26,9 @@ enum COLORS {
     WHITE = FOREGROUND_RED | FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY
 };
 
+class Frame;
+class Sprite;
+
 // Function prototypes
 void setCursorPosition(int x, int y);
 void setColor(COLORS color);
@@ -34,6 +36,20 @@ void hideCursor();
 void showCursor();
 void clearScreen();
 void drawCharAtPosition(int x, int y, char symbol, COLORS color);
-void drawTextAtPosition(int x, int y, const std::string& text, COLORS color);
+void drawTextAtPosition(int x, int y, std::string_view text, COLORS color);
+void drawSpriteAtPosition(int x, int y, const Sprite& sprite);
+
+// While a frame is set as the render target, clearScreen and the draw functions
+// write into it instead of the console (nullptr goes back to the console)
+void setRenderTarget(Frame* frame);
+
+// While a frame is set as the console mirror, everything written to the console is also
+// copied into it, so it always holds what the console shows (nullptr stops mirroring)
+void setConsoleMirror(Frame* frame);
+Frame* getConsoleMirror();
+
+// Switch the console to virtual terminal mode with UTF-8 output, for Frame::presentAnsi;
+// false on consoles without it (before Windows 10)
+bool enableVirtualTerminal();
 
 #endif // CONSOLE_UTILS_H
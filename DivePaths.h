@@ -0,0 +1,120 @@
+#ifndef DIVE_PATHS_H
+#define DIVE_PATHS_H
+
+#include <array>
+#include <cstdint>
+
+// Dive paths are generated at compile time into fixed-point tables with 8 fractional bits.
+// Following a path while playing is then a table load plus the runtime aim offset, never trigonometry.
+const int PATH_SHIFT = 8;
+const int PATH_ONE = 1 << PATH_SHIFT;
+const int DIVE_PATH_LENGTH = 96;
+
+// One entry per tick of a dive, relative to where the enemy left the formation
+struct DivePoint {
+    std::int16_t x;      // Horizontal offset for a dive looping to the right
+    std::int16_t y;      // Vertical offset, positive is down
+    std::int16_t steer;  // Share of the aim offset applied here, PATH_ONE is all of it
+    bool fire;           // Shoot on this tick
+};
+
+using DivePath = std::array<DivePoint, DIVE_PATH_LENGTH>;
+
+constexpr double PATH_PI = 3.14159265358979323846;
+
+// Taylor series sine, good to well below a cell over a full turn; only used at compile time
+constexpr double pathSin(double angle) {
+    while (angle > PATH_PI) {
+        angle -= 2 * PATH_PI;
+    }
+    while (angle < -PATH_PI) {
+        angle += 2 * PATH_PI;
+    }
+
+    double term = angle;
+    double sum = angle;
+    for (int n = 1; n < 12; ++n) {
+        term *= -angle * angle / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double pathCos(double angle) {
+    return pathSin(angle + PATH_PI / 2);
+}
+
+// Cubic Bezier curve in one coordinate
+constexpr double pathBezier(double p0, double p1, double p2, double p3, double t) {
+    double u = 1 - t;
+    return u * u * u * p0 + 3 * u * u * t * p1 + 3 * u * t * t * p2 + t * t * t * p3;
+}
+
+constexpr std::int16_t toPathFixed(double value) {
+    return static_cast<std::int16_t>(value >= 0 ? value * PATH_ONE + 0.5 : value * PATH_ONE - 0.5);
+}
+
+// A Galaga-style dive: a half loop out of the formation, a curved drop that ends above the
+// player (the aim offset is blended in on the way down) and a swing back up into the slot
+constexpr DivePath makeDivePath(double loopRadius, double depth, double sweep) {
+    DivePath path{};
+
+    const int loopTicks = DIVE_PATH_LENGTH / 4;
+    const int dropTicks = (DIVE_PATH_LENGTH - loopTicks) / 2;
+    const int climbTicks = DIVE_PATH_LENGTH - loopTicks - dropTicks;
+    const double loopEnd = 2 * loopRadius;
+
+    for (int i = 0; i < DIVE_PATH_LENGTH; ++i) {
+        double x = 0;
+        double y = 0;
+        double steer = 0;
+        bool fire = false;
+
+        if (i < loopTicks) {
+            // Rise and roll over to the outside; cells are about twice as tall as wide
+            double angle = PATH_PI * (i + 1) / loopTicks;
+            x = loopRadius * (1 - pathCos(angle));
+            y = -0.5 * loopRadius * pathSin(angle);
+        }
+        else if (i < loopTicks + dropTicks) {
+            // Swing back across and drop to just below the formation slot
+            double t = static_cast<double>(i - loopTicks + 1) / dropTicks;
+            x = pathBezier(loopEnd, loopEnd + sweep, -sweep, 0, t);
+            y = pathBezier(0, depth * 0.1, depth * 0.7, depth, t);
+            steer = t;
+            fire = (i - loopTicks) == dropTicks * 2 / 3 || (i - loopTicks) == dropTicks - 2;
+        }
+        else {
+            // Pull out of the dive and climb back into the formation
+            double t = static_cast<double>(i - loopTicks - dropTicks + 1) / climbTicks;
+            x = pathBezier(0, sweep, sweep, 0, t);
+            y = pathBezier(depth, depth, depth * 0.3, 0, t);
+            steer = 1 - t;
+        }
+
+        path[i] = DivePoint{ toPathFixed(x), toPathFixed(y), toPathFixed(steer), fire };
+    }
+    return path;
+}
+
+// Deepest row a path reaches, in whole cells below the start
+constexpr int divePathDepth(const DivePath& path) {
+    int deepest = 0;
+    for (const auto& point : path) {
+        int y = (point.y + PATH_ONE - 1) >> PATH_SHIFT;
+        if (y > deepest) {
+            deepest = y;
+        }
+    }
+    return deepest;
+}
+
+// The available dive shapes
+constexpr DivePath DIVE_HOOK = makeDivePath(5.0, 36.0, 14.0);
+constexpr DivePath DIVE_PLUNGE = makeDivePath(2.0, 50.0, -8.0);
+
+// Every dive ends back in the formation slot
+static_assert(DIVE_HOOK.back().x == 0 && DIVE_HOOK.back().y == 0 && DIVE_HOOK.back().steer == 0);
+static_assert(DIVE_PLUNGE.back().x == 0 && DIVE_PLUNGE.back().y == 0 && DIVE_PLUNGE.back().steer == 0);
+
+#endif // DIVE_PATHS_H
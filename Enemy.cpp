@@ -1,22 +1,32 @@
 #include "Enemy.h"
+#include "Tuning.h"
 
 // Default constructor
-Enemy::Enemy() : GameObject(), direction(1), points(10), shootProbability(0.01) {}
+Enemy::Enemy()
+    : GameObject(), direction(1), points(10), shootProbability(0.01), scriptSlot(-1), pathX(0), pathY(0), heldX(0), heldY(0) {}
 
 // Parameterized constructor
 Enemy::Enemy(int x, int y, char symbol, COLORS color, int direction, int points, double shootProbability)
-    : GameObject(x, y, symbol, color), direction(direction), points(points), shootProbability(shootProbability) {}
+    : GameObject(x, y, symbol, color), direction(direction), points(points), shootProbability(shootProbability), scriptSlot(-1),
+    pathX(0), pathY(0), heldX(0), heldY(0) {}
 
 // Copy constructor
 Enemy::Enemy(const Enemy& other)
-    : GameObject(other), direction(other.direction), points(other.points), shootProbability(other.shootProbability) {}
+    : GameObject(other), direction(other.direction), points(other.points), shootProbability(other.shootProbability),
+    scriptSlot(other.scriptSlot), pathX(other.pathX), pathY(other.pathY), heldX(other.heldX), heldY(other.heldY) {}
 
 // Move constructor
 Enemy::Enemy(Enemy&& other) noexcept
-    : GameObject(std::move(other)), direction(other.direction), points(other.points), shootProbability(other.shootProbability) {
+    : GameObject(std::move(other)), direction(other.direction), points(other.points), shootProbability(other.shootProbability),
+    scriptSlot(other.scriptSlot), pathX(other.pathX), pathY(other.pathY), heldX(other.heldX), heldY(other.heldY) {
     other.direction = 0;
     other.points = 0;
     other.shootProbability = 0.0;
+    other.scriptSlot = -1;
+    other.pathX = 0;
+    other.pathY = 0;
+    other.heldX = 0;
+    other.heldY = 0;
 }
 
 // Destructor
@@ -29,6 +39,11 @@ Enemy& Enemy::operator=(const Enemy& other) {
         direction = other.direction;
         points = other.points;
         shootProbability = other.shootProbability;
+        scriptSlot = other.scriptSlot;
+        pathX = other.pathX;
+        pathY = other.pathY;
+        heldX = other.heldX;
+        heldY = other.heldY;
     }
     return *this;
 }
@@ -40,10 +55,20 @@ Enemy& Enemy::operator=(Enemy&& other) noexcept {
         direction = other.direction;
         points = other.points;
         shootProbability = other.shootProbability;
+        scriptSlot = other.scriptSlot;
+        pathX = other.pathX;
+        pathY = other.pathY;
+        heldX = other.heldX;
+        heldY = other.heldY;
 
         other.direction = 0;
         other.points = 0;
         other.shootProbability = 0.0;
+        other.scriptSlot = -1;
+        other.pathX = 0;
+        other.pathY = 0;
+        other.heldX = 0;
+        other.heldY = 0;
     }
     return *this;
 }
@@ -52,31 +77,46 @@ Enemy& Enemy::operator=(Enemy&& other) noexcept {
 int Enemy::getDirection() const { return direction; }
 int Enemy::getPoints() const { return points; }
 double Enemy::getShootProbability() const { return shootProbability; }
+int Enemy::getScriptSlot() const { return scriptSlot; }
+int Enemy::getPathX() const { return pathX; }
+int Enemy::getPathY() const { return pathY; }
+int Enemy::getHeldX() const { return heldX; }
+int Enemy::getHeldY() const { return heldY; }
+int Enemy::getSlotX() const { return x + heldX - pathX; }
 
 // Setters
 void Enemy::setDirection(int direction) { this->direction = direction; }
+void Enemy::setScriptSlot(int scriptSlot) { this->scriptSlot = scriptSlot; }
+void Enemy::setPath(int pathX, int pathY) {
+    this->pathX = pathX;
+    this->pathY = pathY;
+}
+void Enemy::setHeld(int heldX, int heldY) {
+    this->heldX = heldX;
+    this->heldY = heldY;
+}
+void Enemy::setPoints(int points) { this->points = points; }
+void Enemy::setShootProbability(double shootProbability) { this->shootProbability = shootProbability; }
 
 // Update method
 void Enemy::update() {
     x += direction;
 
     // Change direction if hitting wall
-    if (x <= 0 || x >= POLE_COLS - 1) {
+    if (getLeft() <= 0 || getRight() >= POLE_COLS - 1) {
         direction = -direction;
         y++;  // Move down when changing direction
     }
 }
 
 // Shooting method
-std::unique_ptr<Bullet> Enemy::shoot() const {
-    return std::make_unique<Bullet>(x, y + 1, 'v', RED, 1);
+Bullet Enemy::shoot() const {
+    return Bullet(x, getBottom() + 1, 'v', RED, 1);
 }
 
 // Check if enemy should shoot
-bool Enemy::shouldShoot() const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dis(0.0, 1.0);
+bool Enemy::shouldShoot(std::mt19937& gen) const {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
 
     return dis(gen) < shootProbability;
 }
@@ -97,7 +137,7 @@ std::istream& operator>>(std::istream& is, Enemy& enemy) {
 
 // EnemyType1 implementation
 EnemyType1::EnemyType1(int x, int y)
-    : Enemy(x, y, '&', RED, 1, 10, 0.005) {}
+    : Enemy(x, y, '&', RED, 1, DEFAULT_TUNING.enemies[0].points, DEFAULT_TUNING.enemies[0].shootProbability) {}
 
 EnemyType1::EnemyType1(const EnemyType1& other) : Enemy(other) {}
 
@@ -118,7 +158,7 @@ EnemyType1& EnemyType1::operator=(EnemyType1&& other) noexcept {
 
 // EnemyType2 implementation
 EnemyType2::EnemyType2(int x, int y)
-    : Enemy(x, y, '@', PURPLE, 1, 20, 0.01) {}
+    : Enemy(x, y, '@', PURPLE, 1, DEFAULT_TUNING.enemies[1].points, DEFAULT_TUNING.enemies[1].shootProbability) {}
 
 EnemyType2::EnemyType2(const EnemyType2& other) : Enemy(other) {}
 
@@ -139,7 +179,7 @@ EnemyType2& EnemyType2::operator=(EnemyType2&& other) noexcept {
 
 // EnemyType3 implementation
 EnemyType3::EnemyType3(int x, int y)
-    : Enemy(x, y, '#', CYAN, 1, 30, 0.015) {}
+    : Enemy(x, y, '#', CYAN, 1, DEFAULT_TUNING.enemies[2].points, DEFAULT_TUNING.enemies[2].shootProbability) {}
 
 EnemyType3::EnemyType3(const EnemyType3& other) : Enemy(other) {}
 
@@ -160,7 +200,7 @@ EnemyType3& EnemyType3::operator=(EnemyType3&& other) noexcept {
 
 // EnemyType4 implementation
 EnemyType4::EnemyType4(int x, int y)
-    : Enemy(x, y, '$', YELLOW, 1, 40, 0.02) {}
+    : Enemy(x, y, '$', YELLOW, 1, DEFAULT_TUNING.enemies[3].points, DEFAULT_TUNING.enemies[3].shootProbability) {}
 
 EnemyType4::EnemyType4(const EnemyType4& other) : Enemy(other) {}
 
@@ -178,3 +218,26 @@ EnemyType4& EnemyType4::operator=(EnemyType4&& other) noexcept {
     Enemy::operator=(std::move(other));
     return *this;
 }
+
+// EnemyBoss implementation
+EnemyBoss::EnemyBoss(int x, int y)
+    : Enemy(x, y, 'M', LIGHT_RED, 1, DEFAULT_TUNING.enemies[4].points, DEFAULT_TUNING.enemies[4].shootProbability) {
+    sprite = &BOSS_SPRITE;
+}
+
+EnemyBoss::EnemyBoss(const EnemyBoss& other) : Enemy(other) {}
+
+EnemyBoss::EnemyBoss(EnemyBoss&& other) noexcept
+    : Enemy(std::move(other)) {}
+
+EnemyBoss::~EnemyBoss() {}
+
+EnemyBoss& EnemyBoss::operator=(const EnemyBoss& other) {
+    Enemy::operator=(other);
+    return *this;
+}
+
+EnemyBoss& EnemyBoss::operator=(EnemyBoss&& other) noexcept {
+    Enemy::operator=(std::move(other));
+    return *this;
+}
@@ -11,6 +11,11 @@ protected:
     int direction;  // 1 for right, -1 for left
     int points;     // Points awarded when destroyed
     double shootProbability;
+    int scriptSlot; // Script driving this enemy out of formation, -1 when it just marches
+    int pathX;      // How far the script has taken the enemy from its formation slot
+    int pathY;
+    int heldX;      // Part of that the playfield edges held back, made up once there is room
+    int heldY;
 
 public:
     // Constructors - Big Five rule
@@ -28,16 +33,27 @@ public:
     int getDirection() const;
     int getPoints() const;
     double getShootProbability() const;
+    int getScriptSlot() const;
+    int getPathX() const;
+    int getPathY() const;
+    int getHeldX() const;
+    int getHeldY() const;
+    int getSlotX() const;           // Where the formation slot is while a script has the enemy out of it
     void setDirection(int direction);
+    void setScriptSlot(int scriptSlot);
+    void setPath(int pathX, int pathY);
+    void setHeld(int heldX, int heldY);
+    void setPoints(int points);
+    void setShootProbability(double shootProbability);
 
     // Update method - override from GameObject
     void update() override;
 
     // Shooting method
-    std::unique_ptr<Bullet> shoot() const;
+    Bullet shoot() const;
 
-    // Check if enemy should shoot based on probability
-    bool shouldShoot() const;
+    // Check if enemy should shoot based on probability, drawing from the game's generator
+    bool shouldShoot(std::mt19937& gen) const;
 
     // Stream operators
     friend std::ostream& operator<<(std::ostream& os, const Enemy& enemy);
@@ -45,7 +61,7 @@ public:
 };
 
 // Different types of enemies
-class EnemyType1 : public Enemy {
+class EnemyType1 final : public Enemy {
 public:
     EnemyType1(int x, int y);
     EnemyType1(const EnemyType1& other);
@@ -56,7 +72,7 @@ public:
     EnemyType1& operator=(EnemyType1&& other) noexcept;
 };
 
-class EnemyType2 : public Enemy {
+class EnemyType2 final : public Enemy {
 public:
     EnemyType2(int x, int y);
     EnemyType2(const EnemyType2& other);
@@ -67,7 +83,7 @@ public:
     EnemyType2& operator=(EnemyType2&& other) noexcept;
 };
 
-class EnemyType3 : public Enemy {
+class EnemyType3 final : public Enemy {
 public:
     EnemyType3(int x, int y);
     EnemyType3(const EnemyType3& other);
@@ -78,7 +94,7 @@ public:
     EnemyType3& operator=(EnemyType3&& other) noexcept;
 };
 
-class EnemyType4 : public Enemy {
+class EnemyType4 final : public Enemy {
 public:
     EnemyType4(int x, int y);
     EnemyType4(const EnemyType4& other);
@@ -89,4 +105,16 @@ public:
     EnemyType4& operator=(EnemyType4&& other) noexcept;
 };
 
+// Large multi-cell enemy leading the formation on later levels
+class EnemyBoss final : public Enemy {
+public:
+    EnemyBoss(int x, int y);
+    EnemyBoss(const EnemyBoss& other);
+    EnemyBoss(EnemyBoss&& other) noexcept;
+    ~EnemyBoss() override;
+
+    EnemyBoss& operator=(const EnemyBoss& other);
+    EnemyBoss& operator=(EnemyBoss&& other) noexcept;
+};
+
 #endif // ENEMY_H
\ No newline at end of file
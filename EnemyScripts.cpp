@@ -0,0 +1,90 @@
+#include "EnemyScripts.h"
+
+#include <algorithm>
+
+// Swoop down and back up
+EnemyScript swoopScript(ScriptFramePool&, int depth) {
+    co_await waitTicks(4);
+
+    for (int row = 0; row < depth; ++row) {
+        co_yield EnemyStep{ 0, 1, false };
+        co_await waitTicks(1);
+    }
+
+    co_yield EnemyStep{ 0, 0, true };
+    co_await waitTicks(6);
+
+    for (int row = 0; row < depth; ++row) {
+        co_yield EnemyStep{ 0, -1, false };
+        co_await waitTicks(2);
+    }
+}
+
+// Strafe left and right around the formation slot
+EnemyScript strafeScript(ScriptFramePool&, int width, int passes) {
+    int offset = 0;
+    int direction = 1;
+
+    for (int pass = 0; pass < passes; ++pass) {
+        for (int step = 0; step < width; ++step) {
+            offset += direction;
+            co_yield EnemyStep{ direction, 0, step % 4 == 3 };
+        }
+        direction = -direction;
+        co_await waitTicks(3);
+    }
+
+    // Regroup - walk back to where the formation expects us
+    while (offset != 0) {
+        int step = offset > 0 ? -1 : 1;
+        offset += step;
+        co_yield EnemyStep{ step, 0, false };
+    }
+}
+
+// Walk a dive path table
+EnemyScript diveScript(ScriptFramePool&, const DivePath& path, int mirror, int aim) {
+    int lastX = 0;
+    int lastY = 0;
+
+    for (const auto& point : path) {
+        // Table load plus the aim offset, rounded to whole cells
+        int x = (mirror * point.x + aim * point.steer + PATH_ONE / 2) >> PATH_SHIFT;
+        int y = (point.y + PATH_ONE / 2) >> PATH_SHIFT;
+
+        co_yield EnemyStep{ x - lastX, y - lastY, point.fire };
+        lastX = x;
+        lastY = y;
+    }
+}
+
+// Dispatch on the order
+EnemyScript startEnemyScript(ScriptFramePool& pool, const EnemyScriptArgs& args) {
+    if (args.order == WAVE_SWOOP) {
+        return swoopScript(pool, args.depth);
+    }
+    if (args.order == WAVE_STRAFE) {
+        return strafeScript(pool, args.width, args.passes);
+    }
+    if (args.order == WAVE_DIVE) {
+        return diveScript(pool, *args.path, args.mirror, args.aim);
+    }
+    return EnemyScript();
+}
+
+// Alternate dives, swoops and strafes, more of them and more often on later levels
+WaveScript standardWave(ScriptFramePool&, int level) {
+    int pause = std::max(30, 120 - level * 30);
+
+    // Give the player a moment before anything breaks formation
+    co_await waitTicks(60);
+
+    for (;;) {
+        co_yield WaveStep{ WAVE_DIVE, 1 + level / 2 };
+        co_await waitTicks(pause);
+        co_yield WaveStep{ WAVE_SWOOP, level };
+        co_await waitTicks(pause);
+        co_yield WaveStep{ WAVE_STRAFE, 1 + level / 2 };
+        co_await waitTicks(pause);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef ENEMY_SCRIPTS_H
+#define ENEMY_SCRIPTS_H
+
+#include "Script.h"
+#include "DivePaths.h"
+
+// What a scripted enemy does on one tick, relative to its place in the formation
+struct EnemyStep {
+    int dx = 0;
+    int dy = 0;
+    bool fire = false;
+};
+
+// Behaviours a wave script can hand out to enemies
+enum WaveOrder {
+    WAVE_IDLE = 0,
+    WAVE_SWOOP,
+    WAVE_STRAFE,
+    WAVE_DIVE
+};
+
+// What a wave script asks the game to do on one tick
+struct WaveStep {
+    WaveOrder order = WAVE_IDLE;
+    int count = 0;
+};
+
+using EnemyScript = Script<EnemyStep>;
+using WaveScript = Script<WaveStep>;
+
+// What an enemy script is started with. Scripts depend on nothing else, so these and the
+// script's ticks run are all a snapshot needs to start it again at the same point.
+struct EnemyScriptArgs {
+    WaveOrder order = WAVE_IDLE;        // WAVE_IDLE for no script
+    int depth = 0;                      // Swoop
+    int width = 0;                      // Strafe
+    int passes = 0;
+    const DivePath* path = nullptr;     // Dive
+    int mirror = 0;
+    int aim = 0;
+};
+
+// Drop out of the formation, fire at the bottom of the swoop and climb back into place
+EnemyScript swoopScript(ScriptFramePool& pool, int depth);
+
+// Slide sideways firing every few cells, then return to the formation slot
+EnemyScript strafeScript(ScriptFramePool& pool, int width, int passes);
+
+// Follow a precomputed dive path; mirror is 1 to loop right or -1 to loop left,
+// aim is how far sideways the bottom of the dive should end up from the formation slot
+EnemyScript diveScript(ScriptFramePool& pool, const DivePath& path, int mirror, int aim);
+
+// Start the script for an order; an empty script for WAVE_IDLE
+EnemyScript startEnemyScript(ScriptFramePool& pool, const EnemyScriptArgs& args);
+
+// Per-level wave script deciding when and how many enemies break formation
+WaveScript standardWave(ScriptFramePool& pool, int level);
+
+#endif // ENEMY_SCRIPTS_H
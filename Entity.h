@@ -0,0 +1,29 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include "Enemy.h"
+#include <variant>
+
+// Closed set of enemy kinds, stored by value so a formation is one contiguous array
+using EnemyEntity = std::variant<EnemyType1, EnemyType2, EnemyType3, EnemyType4, EnemyBoss>;
+
+// Static dispatch - std::visit picks the concrete type, and because the enemy types are final
+// the update/render calls below are direct calls instead of going through the vtable
+inline void updateEntity(EnemyEntity& enemy) {
+    std::visit([](auto& e) { e.update(); }, enemy);
+}
+
+inline void renderEntity(const EnemyEntity& enemy) {
+    std::visit([](const auto& e) { e.render(); }, enemy);
+}
+
+// Adapters back to the virtual Enemy/GameObject interface for tooling
+inline Enemy& asEnemy(EnemyEntity& enemy) {
+    return std::visit([](auto& e) -> Enemy& { return e; }, enemy);
+}
+
+inline const Enemy& asEnemy(const EnemyEntity& enemy) {
+    return std::visit([](const auto& e) -> const Enemy& { return e; }, enemy);
+}
+
+#endif // ENTITY_H
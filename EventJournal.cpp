@@ -0,0 +1,143 @@
+#include "EventJournal.h"
+#include <algorithm>
+#include <cstring>
+
+// Constructor - every block is allocated here, and the writer waits for the first one
+EventJournal::EventJournal()
+    : blocks(std::make_unique<Block[]>(JOURNAL_QUEUED_BLOCKS)), current(nullptr), full{}, fullFirst(0), fullCount(0),
+    spare{}, spareCount(0), writing(false), stopping(false) {
+    for (int i = 0; i < JOURNAL_QUEUED_BLOCKS; ++i) {
+        spare[spareCount++] = &blocks[i];
+    }
+    writer = std::thread(&EventJournal::writeLoop, this);
+}
+
+// Destructor
+EventJournal::~EventJournal() {
+    close();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+bool EventJournal::open(const std::string& path, std::uint64_t seed) {
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    JournalHeader header = {};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.seed = seed;
+    header.blockEvents = JOURNAL_BLOCK_EVENTS;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    current = spare[--spareCount];
+    current->count = 0;
+    return true;
+}
+
+// Hand over what is left, wait for the writer to get it all to the file, and close it
+void EventJournal::close() {
+    if (current == nullptr) {
+        return;
+    }
+    handOff();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return fullCount == 0 && !writing; });
+    spare[spareCount++] = current;
+    current = nullptr;
+    file.close();
+}
+
+bool EventJournal::isOpen() const {
+    return current != nullptr;
+}
+
+// Record an event - a handful of stores, plus a block handed to the writer every JOURNAL_BLOCK_EVENTS events
+void EventJournal::record(EventKind kind, std::uint32_t tick, int level, int subject, int x, int y, int value) {
+    if (current == nullptr) {
+        return;
+    }
+    if (current->count == JOURNAL_BLOCK_EVENTS) {
+        handOff();
+    }
+    Block& block = *current;
+    int i = block.count;
+    block.ticks[i] = tick;
+    block.values[i] = value;
+    block.xs[i] = static_cast<std::int16_t>(x);
+    block.ys[i] = static_cast<std::int16_t>(y);
+    block.kinds[i] = kind;
+    block.levels[i] = static_cast<std::uint16_t>(std::clamp(level, 0, JOURNAL_MAX_LEVEL));
+    block.subjects[i] = static_cast<std::uint8_t>(subject);
+    block.count = i + 1;
+}
+
+// Queue the current block for writing and take a spare one, waiting only if none is left
+void EventJournal::handOff() {
+    if (current->count == 0) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        full[(fullFirst + fullCount) % JOURNAL_QUEUED_BLOCKS] = current;
+        ++fullCount;
+        wake.notify_one();
+        done.wait(lock, [this] { return spareCount > 0; });
+        current = spare[--spareCount];
+    }
+    current->count = 0;
+}
+
+// Writer thread - writes full blocks in order and gives them back
+void EventJournal::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return stopping || fullCount > 0; });
+        if (fullCount == 0) {
+            return;
+        }
+        Block* block = full[fullFirst];
+        fullFirst = (fullFirst + 1) % JOURNAL_QUEUED_BLOCKS;
+        --fullCount;
+        writing = true;
+
+        lock.unlock();
+        writeBlock(*block);
+        lock.lock();
+
+        writing = false;
+        spare[spareCount++] = block;
+        done.notify_all();
+    }
+}
+
+void EventJournal::writeColumn(const void* data, std::size_t count, std::size_t elementSize) {
+    static const char PADDING[JOURNAL_ALIGNMENT] = {};
+    std::size_t bytes = count * elementSize;
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    file.write(PADDING, static_cast<std::streamsize>(journalColumnBytes(count, elementSize) - bytes));
+}
+
+// Write one block, widest columns first
+void EventJournal::writeBlock(const Block& block) {
+    std::size_t count = static_cast<std::size_t>(block.count);
+    JournalBlockHeader header = {};
+    header.count = static_cast<std::uint32_t>(count);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeColumn(block.ticks, count, sizeof(block.ticks[0]));
+    writeColumn(block.values, count, sizeof(block.values[0]));
+    writeColumn(block.xs, count, sizeof(block.xs[0]));
+    writeColumn(block.ys, count, sizeof(block.ys[0]));
+    writeColumn(block.levels, count, sizeof(block.levels[0]));
+    writeColumn(block.kinds, count, sizeof(block.kinds[0]));
+    writeColumn(block.subjects, count, sizeof(block.subjects[0]));
+    file.flush();
+}
@@ -0,0 +1,117 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Gameplay events written to a per-run journal file.
+//
+// The file is a JournalHeader followed by blocks of up to JOURNAL_BLOCK_EVENTS events. A block is
+// a JournalBlockHeader and then one column per field - all ticks, then all values, and so on -
+// each padded to 16 bytes, so a mapped file can be scanned a column at a time with SIMD.
+// Levels are stored in 16 bits; an endless run past level 65535 records that level from then on.
+
+enum EventKind : std::uint8_t {
+    EVENT_KILL = 0,         // subject: enemy type, value: points awarded
+    EVENT_PLAYER_HIT,       // value: lives left
+    EVENT_PLAYER_SHOT,
+    EVENT_ENEMY_SHOT,       // subject: enemy type
+    EVENT_LEVEL_START,      // value: level
+    EVENT_EXTRA_LIFE,       // value: lives after the award
+    EVENT_KIND_COUNT
+};
+
+const char JOURNAL_MAGIC[8] = { 'G', 'O', '2', 'E', 'V', 'J', '0', '2' };
+const int JOURNAL_BLOCK_EVENTS = 4096;
+const int JOURNAL_MAX_LEVEL = 65535;
+const std::size_t JOURNAL_ALIGNMENT = 16;
+
+struct JournalHeader {
+    char magic[8];
+    std::uint64_t seed;
+    std::uint32_t blockEvents;
+    std::uint32_t reserved[3];
+};
+
+struct JournalBlockHeader {
+    std::uint32_t count;
+    std::uint32_t reserved[3];
+};
+
+static_assert(sizeof(JournalHeader) % JOURNAL_ALIGNMENT == 0, "columns must stay aligned");
+static_assert(sizeof(JournalBlockHeader) % JOURNAL_ALIGNMENT == 0, "columns must stay aligned");
+
+// Bytes a column of count elements of the given size takes, padding included
+inline std::size_t journalColumnBytes(std::size_t count, std::size_t elementSize) {
+    return (count * elementSize + JOURNAL_ALIGNMENT - 1) / JOURNAL_ALIGNMENT * JOURNAL_ALIGNMENT;
+}
+
+// Writer - events are stored straight into the columns of the current block. A full block is
+// handed to a writer thread, which writes it to the file in one go while the game fills the next,
+// so recording stays a handful of stores. Blocks come from a fixed set of JOURNAL_QUEUED_BLOCKS;
+// only if the disk falls that far behind does recording wait for the writer, so no event is lost.
+class EventJournal {
+private:
+    struct Block {
+        int count;
+        std::uint32_t ticks[JOURNAL_BLOCK_EVENTS];
+        std::int32_t values[JOURNAL_BLOCK_EVENTS];
+        std::int16_t xs[JOURNAL_BLOCK_EVENTS];
+        std::int16_t ys[JOURNAL_BLOCK_EVENTS];
+        std::uint8_t kinds[JOURNAL_BLOCK_EVENTS];
+        std::uint16_t levels[JOURNAL_BLOCK_EVENTS];
+        std::uint8_t subjects[JOURNAL_BLOCK_EVENTS];
+    };
+
+    static const int JOURNAL_QUEUED_BLOCKS = 4;
+
+    std::ofstream file;     // Written by the writer thread; opened and closed with the queue drained
+    std::unique_ptr<Block[]> blocks;
+    Block* current;         // Being filled by the game thread, nullptr while the journal is closed
+
+    // Shared with the writer thread - full blocks in order, and blocks free to fill
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    Block* full[JOURNAL_QUEUED_BLOCKS];
+    int fullFirst;
+    int fullCount;
+    Block* spare[JOURNAL_QUEUED_BLOCKS];
+    int spareCount;
+    bool writing;           // The writer holds a block taken off the queue
+    bool stopping;
+
+    std::thread writer;
+
+    void handOff();
+    void writeLoop();
+    void writeBlock(const Block& block);
+    void writeColumn(const void* data, std::size_t count, std::size_t elementSize);
+
+public:
+    // Constructors - owns a file and a thread, so it cannot be copied or moved
+    EventJournal();
+    EventJournal(const EventJournal& other) = delete;
+    EventJournal(EventJournal&& other) = delete;
+    ~EventJournal();
+
+    // Assignment operator
+    EventJournal& operator=(const EventJournal& other) = delete;
+    EventJournal& operator=(EventJournal&& other) = delete;
+
+    // Start a new journal file, closing the previous one
+    bool open(const std::string& path, std::uint64_t seed);
+    void close();
+    bool isOpen() const;
+
+    // Append an event
+    void record(EventKind kind, std::uint32_t tick, int level, int subject, int x, int y, int value);
+};
+
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,215 @@
+#include "Frame.h"
+#include "Sprite.h"
+#include "AnsiEncoder.h"
+
+#include <algorithm>
+
+static const Cell BLANK_CELL = { ' ', WHITE };
+
+// Room presentAnsi reserves up front: the largest frame in the rich style, encoded in both orders
+static const std::size_t ANSI_BUFFER_BYTES = 1024 * 1024;
+
+// Default constructor
+Frame::Frame()
+    : cells(POLE_COLS * POLE_ROWS, BLANK_CELL), consoleBuffer(POLE_COLS * POLE_ROWS),
+    shown(POLE_COLS * POLE_ROWS, BLANK_CELL), shownValid(false) {}
+
+// Copy constructor - the copy hasn't been presented anywhere yet
+Frame::Frame(const Frame& other)
+    : cells(other.cells), consoleBuffer(POLE_COLS * POLE_ROWS),
+    shown(POLE_COLS * POLE_ROWS, BLANK_CELL), shownValid(false) {}
+
+// Move constructor
+Frame::Frame(Frame&& other) noexcept
+    : cells(std::move(other.cells)), consoleBuffer(std::move(other.consoleBuffer)), ansiBuffer(std::move(other.ansiBuffer)),
+    ansiTerminal(other.ansiTerminal), shown(std::move(other.shown)), shownValid(other.shownValid) {
+    other.shownValid = false;
+}
+
+// Destructor
+Frame::~Frame() {}
+
+// Copy assignment operator
+Frame& Frame::operator=(const Frame& other) {
+    if (this != &other) {
+        cells = other.cells;
+        shownValid = false;
+    }
+    return *this;
+}
+
+// Move assignment operator
+Frame& Frame::operator=(Frame&& other) noexcept {
+    if (this != &other) {
+        cells = std::move(other.cells);
+        consoleBuffer = std::move(other.consoleBuffer);
+        ansiBuffer = std::move(other.ansiBuffer);
+        ansiTerminal = other.ansiTerminal;
+        shown = std::move(other.shown);
+        shownValid = other.shownValid;
+        other.shownValid = false;
+    }
+    return *this;
+}
+
+// Clear the frame
+void Frame::clear() {
+    std::fill(cells.begin(), cells.end(), BLANK_CELL);
+}
+
+// Draw a single character
+void Frame::put(int x, int y, char glyph, COLORS color) {
+    if (x < 0 || x >= POLE_COLS || y < 0 || y >= POLE_ROWS) {
+        return;
+    }
+    cells[y * POLE_COLS + x] = Cell{ glyph, color };
+}
+
+// Draw a line of text
+void Frame::putText(int x, int y, std::string_view text, COLORS color) {
+    if (y < 0 || y >= POLE_ROWS) {
+        return;
+    }
+    Cell* row = &cells[y * POLE_COLS];
+    for (std::size_t i = 0; i < text.length(); ++i) {
+        int col = x + static_cast<int>(i);
+        if (col >= 0 && col < POLE_COLS) {
+            row[col] = Cell{ text[i], color };
+        }
+    }
+}
+
+// Copy a sprite's solid cells into the frame, a row at a time
+void Frame::blit(int left, int top, const Sprite& sprite) {
+    for (int row = 0; row < sprite.getHeight(); ++row) {
+        int y = top + row;
+        if (y < 0 || y >= POLE_ROWS) {
+            continue;
+        }
+
+        Cell* line = &cells[y * POLE_COLS];
+        std::uint64_t mask = sprite.getMask(row);
+        for (int col = 0; mask != 0; ++col, mask >>= 1) {
+            int x = left + col;
+            if ((mask & 1) && x >= 0 && x < POLE_COLS) {
+                line[x] = Cell{ sprite.getGlyph(col, row), sprite.getColor(col, row) };
+            }
+        }
+    }
+}
+
+// Read a cell
+const Cell& Frame::at(int x, int y) const {
+    return cells[y * POLE_COLS + x];
+}
+
+// Copy a rectangle row by row
+void Frame::copyRegion(const Frame& source, int left, int top, int right, int bottom) {
+    for (int y = top; y <= bottom; ++y) {
+        std::size_t start = static_cast<std::size_t>(y) * POLE_COLS + left;
+        std::copy(source.cells.begin() + start, source.cells.begin() + start + (right - left + 1), cells.begin() + start);
+    }
+}
+
+// Raw row-major cell data
+const Cell* Frame::data() const {
+    return cells.data();
+}
+
+// Present the frame with one console write instead of a cursor move per character
+void Frame::present() const {
+    writeRegion(0, 0, POLE_COLS - 1, POLE_ROWS - 1);
+    shownValid = true;
+}
+
+// Present only the changed rows
+void Frame::presentChanges() const {
+    if (!shownValid) {
+        present();
+        return;
+    }
+
+    // Grow a rectangle over consecutive changed rows and write it when the run ends
+    int runTop = -1;
+    int runLeft = POLE_COLS;
+    int runRight = -1;
+    for (int y = 0; y <= POLE_ROWS; ++y) {
+        int left = POLE_COLS;
+        int right = -1;
+        if (y < POLE_ROWS) {
+            const Cell* row = &cells[y * POLE_COLS];
+            const Cell* old = &shown[y * POLE_COLS];
+            for (int x = 0; x < POLE_COLS; ++x) {
+                if (row[x].glyph != old[x].glyph || row[x].color != old[x].color) {
+                    left = std::min(left, x);
+                    right = x;
+                }
+            }
+        }
+
+        if (right >= 0) {
+            if (runTop < 0) {
+                runTop = y;
+            }
+            runLeft = std::min(runLeft, left);
+            runRight = std::max(runRight, right);
+        }
+        else if (runTop >= 0) {
+            writeRegion(runLeft, runTop, runRight, y - 1);
+            runTop = -1;
+            runLeft = POLE_COLS;
+            runRight = -1;
+        }
+    }
+}
+
+// Present as escape sequences; the buffer is reserved on the first call, before the steady state
+void Frame::presentAnsi(const AnsiStyle& style, bool changesOnly) const {
+    if (ansiBuffer.capacity() < ANSI_BUFFER_BYTES) {
+        ansiBuffer.reserve(ANSI_BUFFER_BYTES);
+    }
+    ansiBuffer.clear();
+    if (changesOnly && shownValid) {
+        encodeCells(shown.data(), cells.data(), ansiBuffer, ansiTerminal, style);
+    }
+    else {
+        encodeKeyframe(*this, ansiBuffer, ansiTerminal, style);
+    }
+
+    DWORD written;
+    WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), ansiBuffer.data(), static_cast<DWORD>(ansiBuffer.size()), &written, nullptr);
+    std::copy(cells.begin(), cells.end(), shown.begin());
+    shownValid = true;
+
+    Frame* mirror = getConsoleMirror();
+    if (mirror && mirror != this) {
+        mirror->copyRegion(*this, 0, 0, POLE_COLS - 1, POLE_ROWS - 1);
+    }
+}
+
+// Forget the console contents
+void Frame::invalidate() {
+    shownValid = false;
+}
+
+// Convert a rectangle to console cells and write it in one call
+void Frame::writeRegion(int left, int top, int right, int bottom) const {
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+            std::size_t i = static_cast<std::size_t>(y) * POLE_COLS + x;
+            consoleBuffer[i].Char.AsciiChar = cells[i].glyph;
+            consoleBuffer[i].Attributes = static_cast<WORD>(cells[i].color);
+            shown[i] = cells[i];
+        }
+    }
+
+    COORD bufferSize = { static_cast<SHORT>(POLE_COLS), static_cast<SHORT>(POLE_ROWS) };
+    COORD bufferStart = { static_cast<SHORT>(left), static_cast<SHORT>(top) };
+    SMALL_RECT region = { static_cast<SHORT>(left), static_cast<SHORT>(top), static_cast<SHORT>(right), static_cast<SHORT>(bottom) };
+    WriteConsoleOutputA(GetStdHandle(STD_OUTPUT_HANDLE), consoleBuffer.data(), bufferSize, bufferStart, &region);
+
+    Frame* mirror = getConsoleMirror();
+    if (mirror && mirror != this) {
+        mirror->copyRegion(*this, left, top, right, bottom);
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "ConsoleUtils.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Sprite;
+struct AnsiStyle;
+
+// One character cell of the screen
+struct Cell {
+    char glyph;
+    COLORS color;
+};
+
+// Where a terminal's cursor and colour are after what was written to it so far, as far as the
+// writer knows (-1 for unknown). ANSI messages pick up from it, so each end of a stream keeps one.
+struct TerminalState {
+    int x = -1;
+    int y = -1;
+    int color = -1;
+};
+
+// Off-screen cell grid covering the whole playing field.
+// A tick is drawn into a frame and then written to the console in a single call.
+class Frame {
+private:
+    std::vector<Cell> cells;
+    mutable std::vector<CHAR_INFO> consoleBuffer;
+    mutable std::string ansiBuffer;
+    mutable TerminalState ansiTerminal;
+
+    // What the console shows since the last present, for diff output
+    mutable std::vector<Cell> shown;
+    mutable bool shownValid;
+
+    // Write a rectangle of the frame to the console and remember it as shown
+    void writeRegion(int left, int top, int right, int bottom) const;
+
+public:
+    // Constructors - Big Five rule
+    Frame();
+    Frame(const Frame& other);
+    Frame(Frame&& other) noexcept;
+    ~Frame();
+
+    // Assignment operator
+    Frame& operator=(const Frame& other);
+    Frame& operator=(Frame&& other) noexcept;
+
+    // Fill every cell with a blank
+    void clear();
+
+    // Drawing - anything outside the field is clipped
+    void put(int x, int y, char glyph, COLORS color);
+    void putText(int x, int y, std::string_view text, COLORS color);
+    void blit(int left, int top, const Sprite& sprite);
+
+    // Copy a rectangle of another frame into the same place in this one
+    void copyRegion(const Frame& source, int left, int top, int right, int bottom);
+
+    // Read access
+    const Cell& at(int x, int y) const;
+    const Cell* data() const;
+
+    // Write the whole frame to the console
+    void present() const;
+
+    // Write only what changed since the last present, one rectangle per run of changed rows;
+    // falls back to a full present when the console contents are unknown
+    void presentChanges() const;
+
+    // Write the frame as ANSI escape sequences in the given style, to a console in virtual
+    // terminal mode (enableVirtualTerminal); only the changes unless changesOnly is off or the
+    // console contents are unknown
+    void presentAnsi(const AnsiStyle& style, bool changesOnly) const;
+
+    // Forget what the console shows, after something drew to it around the frame
+    void invalidate();
+};
+
+#endif // FRAME_H
@@ -0,0 +1,19 @@
+#include "FrameArena.h"
+
+// Constructor
+// Overflowing the buffer falls back to the global heap, which shows up in the allocation counter
+FrameArena::FrameArena()
+    : resource(buffer, CAPACITY, std::pmr::new_delete_resource()) {}
+
+// Destructor
+FrameArena::~FrameArena() {}
+
+// Memory resource for the current tick
+std::pmr::memory_resource* FrameArena::get() {
+    return &resource;
+}
+
+// Reset the arena back to the start of its buffer
+void FrameArena::reset() {
+    resource.release();
+}
@@ -0,0 +1,34 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Bump allocator for data that only lives for one game tick.
+// Everything allocated from it is released at once by reset().
+class FrameArena {
+private:
+    static const std::size_t CAPACITY = 64 * 1024;
+
+    alignas(std::max_align_t) std::byte buffer[CAPACITY];
+    std::pmr::monotonic_buffer_resource resource;
+
+public:
+    // Constructors - the arena owns its buffer, so it cannot be copied or moved
+    FrameArena();
+    FrameArena(const FrameArena& other) = delete;
+    FrameArena(FrameArena&& other) = delete;
+    ~FrameArena();
+
+    // Assignment operator
+    FrameArena& operator=(const FrameArena& other) = delete;
+    FrameArena& operator=(FrameArena&& other) = delete;
+
+    // Memory resource to hand to pmr containers for the current tick
+    std::pmr::memory_resource* get();
+
+    // Release everything allocated during the tick
+    void reset();
+};
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,112 @@
+#include "FrameGovernor.h"
+
+// Settings from best to cheapest
+struct GovernorStep {
+    int renderInterval;     // Ticks per rendered frame
+    RenderQuality quality;
+};
+
+static const GovernorStep LADDER[] = {
+    { 1, QUALITY_FULL },
+    { 1, QUALITY_DIFF },
+    { 2, QUALITY_DIFF },
+    { 2, QUALITY_REDUCED },
+    { 3, QUALITY_REDUCED },
+    { 4, QUALITY_REDUCED },
+};
+static const int LADDER_STEPS = sizeof(LADDER) / sizeof(LADDER[0]);
+
+// Weight of the newest sample in the moving averages
+static const double SMOOTHING = 0.1;
+
+// A frame period is over budget above the first fraction and has headroom below the second
+static const double OVER_BUDGET = 0.9;
+static const double HEADROOM = 0.4;
+
+static double microseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+// Constructor
+FrameGovernor::FrameGovernor(std::chrono::microseconds tickBudget)
+    : tickBudget(tickBudget), tickTime(0.0), drawTime(0.0), presentTime(0.0),
+    step(0), slowFrames(0), fastFrames(0), skipFrame(false) {}
+
+// Fold in the time a simulation tick took
+void FrameGovernor::recordTick(std::chrono::nanoseconds duration) {
+    tickTime += SMOOTHING * (microseconds(duration) - tickTime);
+}
+
+// Fold in a rendered frame and adjust the setting if it has been off budget for long enough
+void FrameGovernor::recordFrame(std::chrono::nanoseconds draw, std::chrono::nanoseconds present) {
+    if (skipFrame) {
+        skipFrame = false;
+        return;
+    }
+
+    drawTime += SMOOTHING * (microseconds(draw) - drawTime);
+    presentTime += SMOOTHING * (microseconds(present) - presentTime);
+
+    int interval = getRenderInterval();
+    double cost = interval * tickTime + drawTime + presentTime;
+    double budget = interval * static_cast<double>(tickBudget.count());
+
+    if (cost > OVER_BUDGET * budget) {
+        fastFrames = 0;
+        if (++slowFrames >= ADJUST_AFTER_FRAMES && step + 1 < LADDER_STEPS) {
+            ++step;
+            slowFrames = 0;
+        }
+    }
+    else if (cost < HEADROOM * budget) {
+        slowFrames = 0;
+        if (++fastFrames >= ADJUST_AFTER_FRAMES && step > 0) {
+            --step;
+            fastFrames = 0;
+        }
+    }
+    else {
+        slowFrames = 0;
+        fastFrames = 0;
+    }
+}
+
+// Forget the frames-in-a-row counts after the game was held up by a screen or pause, and leave
+// the full redraw that follows out of the averages
+void FrameGovernor::restartMeasurement() {
+    slowFrames = 0;
+    fastFrames = 0;
+    skipFrame = true;
+}
+
+void FrameGovernor::setTickBudget(std::chrono::microseconds budget) {
+    tickBudget = budget;
+}
+
+bool FrameGovernor::shouldRender(std::uint64_t tick) const {
+    return tick % LADDER[step].renderInterval == 0;
+}
+
+int FrameGovernor::getRenderInterval() const { return LADDER[step].renderInterval; }
+RenderQuality FrameGovernor::getQuality() const { return LADDER[step].quality; }
+bool FrameGovernor::useDiffOutput() const { return LADDER[step].quality != QUALITY_FULL; }
+bool FrameGovernor::drawDecorations() const { return LADDER[step].quality != QUALITY_REDUCED; }
+
+int FrameGovernor::getTargetFps() const {
+    return static_cast<int>(1000000 / (tickBudget.count() * LADDER[step].renderInterval));
+}
+
+double FrameGovernor::getTickMs() const { return tickTime / 1000.0; }
+double FrameGovernor::getDrawMs() const { return drawTime / 1000.0; }
+double FrameGovernor::getPresentMs() const { return presentTime / 1000.0; }
+
+const char* FrameGovernor::getQualityName() const {
+    switch (LADDER[step].quality) {
+    case QUALITY_FULL:
+        return "full";
+    case QUALITY_DIFF:
+        return "diff";
+    default:
+        return "reduced";
+    }
+}
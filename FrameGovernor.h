@@ -0,0 +1,71 @@
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <chrono>
+#include <cstdint>
+
+// How much of each frame is drawn and how it is written
+enum RenderQuality {
+    QUALITY_FULL = 0,       // Whole frame, every layer
+    QUALITY_DIFF,           // Only changed rows are written
+    QUALITY_REDUCED         // Changed rows only, decorative layers (particles) dropped
+};
+
+// Adapts rendering to how fast the console actually is.
+// The simulation always ticks at a fixed rate; the governor measures tick, draw and present
+// times and walks a ladder of render settings - diff output first, then fewer frames per
+// tick, then dropping decorative layers - when frames don't fit their time budget, and walks
+// back up once there is plenty of headroom. A setting has to be over or under budget for a
+// number of frames in a row before it changes, so it doesn't flap.
+class FrameGovernor {
+private:
+    // Frames in a row that must be over (or well under) budget before changing setting
+    static const int ADJUST_AFTER_FRAMES = 15;
+
+    std::chrono::microseconds tickBudget;
+
+    // Moving averages, in microseconds
+    double tickTime;
+    double drawTime;
+    double presentTime;
+
+    int step;               // Position on the ladder, 0 is full quality every tick
+    int slowFrames;
+    int fastFrames;
+    bool skipFrame;         // Next frame is a full redraw after a stall - don't measure it
+
+public:
+    // Constructors - plain data, so the defaults are enough
+    explicit FrameGovernor(std::chrono::microseconds tickBudget);
+    FrameGovernor(const FrameGovernor& other) = default;
+    FrameGovernor(FrameGovernor&& other) noexcept = default;
+    ~FrameGovernor() = default;
+
+    // Assignment operator
+    FrameGovernor& operator=(const FrameGovernor& other) = default;
+    FrameGovernor& operator=(FrameGovernor&& other) noexcept = default;
+
+    // Measurements
+    void recordTick(std::chrono::nanoseconds duration);
+    void recordFrame(std::chrono::nanoseconds draw, std::chrono::nanoseconds present);
+    void restartMeasurement();
+
+    // Real time one tick has, which changes with Tuning::tickMilliseconds
+    void setTickBudget(std::chrono::microseconds budget);
+
+    // Current setting
+    bool shouldRender(std::uint64_t tick) const;
+    int getRenderInterval() const;
+    RenderQuality getQuality() const;
+    bool useDiffOutput() const;
+    bool drawDecorations() const;
+
+    // Figures for the status bar
+    int getTargetFps() const;
+    double getTickMs() const;
+    double getDrawMs() const;
+    double getPresentMs() const;
+    const char* getQualityName() const;
+};
+
+#endif // FRAME_GOVERNOR_H
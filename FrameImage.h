@@ -0,0 +1,27 @@
+#ifndef FRAME_IMAGE_H
+#define FRAME_IMAGE_H
+
+#include "Frame.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Rasterising frames into images with a built-in 5x7 bitmap font and the console palette.
+// Images are 8-bit palette indices (the COLORS values), one byte per pixel, row by row.
+
+const int GLYPH_WIDTH = 6;
+const int GLYPH_HEIGHT = 8;
+const int IMAGE_WIDTH = POLE_COLS * GLYPH_WIDTH;
+const int IMAGE_HEIGHT = POLE_ROWS * GLYPH_HEIGHT;
+const int PALETTE_SIZE = 16;
+
+// RGB of each console colour, as the classic Windows console shows them
+extern const std::uint8_t CONSOLE_PALETTE[PALETTE_SIZE][3];
+
+// Rasterise a rectangle of cells (inclusive bounds) into a buffer of its own size
+void rasterizeCells(const Frame& frame, int left, int top, int right, int bottom, std::vector<std::uint8_t>& pixels);
+
+// Write an image of the whole frame as a binary PPM
+void writePpm(const Frame& frame, std::ostream& out);
+
+#endif // FRAME_IMAGE_H
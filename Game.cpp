@@ -1,17 +1,150 @@
 #include "Game.h"
 
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+
+// Size of one coroutine frame in the script pool
+static const std::size_t SCRIPT_FRAME_SIZE = 512;
+
+// Simulated time per tick, matching the frame pacing in run()
+static const std::chrono::milliseconds TICK_DURATION(50);
+
+// Levels with a hand-made formation; endless mode generates the ones after them
+static const int SCRIPTED_LEVELS = 3;
+
+// Enemies plus bullets from which a tick is worth spreading over the job system
+static const std::size_t PARALLEL_TICK_THRESHOLD = 256;
+
+// Ticks run back to back to catch up before the backlog is dropped
+static const int MAX_CATCH_UP_TICKS = 5;
+
+// Ticks after the start of a level before allocations count as steady state
+static const int STEADY_STATE_TICKS = 10;
+
+// Bullets reserved up front, so firing doesn't grow the vector in steady state
+static const std::size_t BULLET_CAPACITY = 512;
+
+// Broad phase marker for an enemy bullet that overlaps the player
+static const std::uint32_t PLAYER_CANDIDATE = 0xFFFFFFFF;
+static const std::uint32_t PARTNER_CANDIDATE = 0xFFFFFFFE;
+
+// Append a number to a string without going through a std::to_string temporary
+static void appendNumber(std::pmr::string& text, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+}
+
+// Append a duration as milliseconds with one decimal
+static void appendMilliseconds(std::pmr::string& text, double milliseconds) {
+    int tenths = static_cast<int>(milliseconds * 10.0 + 0.5);
+    appendNumber(text, tenths / 10);
+    text += '.';
+    appendNumber(text, tenths % 10);
+    text += " ms";
+}
+
 // Constructor
-Game::Game()
-    : score(0), level(1), running(true), paused(false),
+Game::Game(const GameOptions& options)
+    : governor(std::chrono::milliseconds(DEFAULT_TUNING.tickMilliseconds)), scriptPool(SCRIPT_FRAME_SIZE, options.maxScripts), twoPlayers(options.twoPlayers),
+    waveLevel(1), score(0), level(1), running(true), won(false), paused(false), extraLifeAwarded(false),
+    headless(options.headless),
+    ansiStyle(options.richOutput ? &richAnsiStyle() : &plainAnsiStyle()), virtualTerminal(false),
+    autopilotEnabled(options.autopilot),
+    assertNoAllocations(options.assertNoAllocations), levelTicks(0), endless(options.endless), waveSeed(options.seed),
     enemyUpdateInterval(std::chrono::milliseconds(500)), enemyShootInterval(std::chrono::milliseconds(1000)),
     enemyRows(5), enemyCols(10),
-    gen(rd()) {
+    simulationTime(0), lastEnemyUpdate(0), lastEnemyShoot(0),
+    tickParts(1), enemyTick(false), shootTick(false), marchDirection(1),
+    collisionEvents(BULLET_CAPACITY + 2), bunkerHits{},
+    tickAllocations(0) {
+
+    // Every random decision flows from one seed
+    if (waveSeed == 0) {
+        waveSeed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    }
+    gen.seed(static_cast<std::mt19937::result_type>(waveSeed));
 
     // Initialize level messages
     levelMessages[1] = "Level 1: Basic Invasion";
     levelMessages[2] = "Level 2: Aggressive Attack";
     levelMessages[3] = "Level 3: Final Assault";
 
+    enemyScripts.reserve(options.maxScripts);
+    enemyScriptArgs.reserve(options.maxScripts);
+    freeScriptSlots.reserve(options.maxScripts);
+    bullets.reserve(BULLET_CAPACITY);
+    spent.reserve(BULLET_CAPACITY);
+
+    // Two slices per thread, so stealing can even out uneven slices
+    if (options.workerThreads > 0) {
+        jobSystem = std::make_unique<JobSystem>(options.workerThreads);
+        tickParts = std::min(options.workerThreads * 2, POLE_ROWS);
+        sliceAtEdge.assign(tickParts, 0);
+        sliceOccupied.resize(tickParts);
+        candidates.resize(tickParts);
+
+        // Jobs run with allocations checked like the rest of the tick, so the broad phase
+        // tables are sized for the most bullets up front
+        bulletRowStart.reserve(POLE_ROWS + 1);
+        bulletRowFill.reserve(POLE_ROWS + 1);
+        enemyRowStart.reserve(POLE_ROWS + 1);
+        enemyRowFill.reserve(POLE_ROWS + 1);
+        bulletsByRow.reserve(BULLET_CAPACITY);
+        candidateBegin.reserve(BULLET_CAPACITY);
+        candidateEnd.reserve(BULLET_CAPACITY);
+        for (auto& band : candidates) {
+            band.reserve(BULLET_CAPACITY);
+        }
+        buildTickGraph();
+    }
+
+    // Older consoles without virtual terminal support keep the console buffer writes
+    if (options.virtualTerminal && !options.headless) {
+        virtualTerminal = enableVirtualTerminal();
+    }
+
+    // A headless game never renders, so there is nothing to watch
+    if (options.spectatorPort != 0 && !options.headless) {
+        spectators = std::make_unique<SpectatorServer>(options.spectatorPort, *ansiStyle);
+    }
+    if (options.shareState && !options.headless) {
+        statePublisher = std::make_unique<StatePublisher>();
+    }
+    if (!options.recordPath.empty() && !options.headless) {
+        recorder = std::make_unique<SessionRecorder>(options.recordPath, *ansiStyle);
+    }
+    if (!options.journalDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(options.journalDirectory, error);
+        if (error) {
+            std::cerr << "Could not create journal directory " << options.journalDirectory << ": " << error.message() << std::endl;
+        }
+        else {
+            journal = std::make_unique<EventJournal>();
+            journalDirectory = options.journalDirectory;
+        }
+    }
+    tuning = &DEFAULT_TUNING;
+    if (!options.tuningPath.empty()) {
+        tuningWatcher = std::make_unique<TuningWatcher>(options.tuningPath);
+        tuning = tuningWatcher->current();
+        tuningWatcher->acknowledge(tuning);
+    }
+    governor.setTickBudget(std::chrono::milliseconds(tuning->tickMilliseconds));
+    bestScore = 0;
+    runRank = 0;
+    if (!options.scoreFile.empty()) {
+        scores = std::make_unique<ScoreTable>(options.scoreFile);
+        playerName = options.playerName;
+        ScoreRecord best;
+        if (scores->best(playerName, best)) {
+            bestScore = best.score;
+        }
+    }
+
     initialize();
 }
 
@@ -19,118 +152,344 @@ Game::Game()
 Game::~Game() {}
 
 void Game::initialize() {
-    clearScreen();
-    hideCursor();
+    AllocationTag tag("initialize");
+    if (!headless) {
+        clearScreen();
+        hideCursor();
+    }
 
-    player = Player(POLE_COLS / 2, POLE_ROWS - 5, 'A', GREEN);
+    // Two ships start a third of the way in from either side
+    player = Player(twoPlayers ? POLE_COLS / 3 : POLE_COLS / 2, POLE_ROWS - 5, 'A', GREEN);
+    player.setSprite(&PLAYER_SHIP_SPRITE);
     player.setLives(3);
     player.setScore(0);
+    if (twoPlayers) {
+        partner = Player(POLE_COLS * 2 / 3, POLE_ROWS - 5, 'B', CYAN);
+        partner.setSprite(&PARTNER_SHIP_SPRITE);
+    }
 
-    initializeEnemies();
+    if (isGeneratedLevel(level)) {
+        applyWave(generateWave(waveSeed, level));
+    }
+    else {
+        // The formation size comes from the level parameters, so they go first
+        setLevelParameters();
+        initializeEnemies();
+    }
+    if (isGeneratedLevel(level + 1)) {
+        prepareNextWave();
+    }
+    applyTuning();
 
     bullets.clear();
+    bunkers.reset();
+    particles.clear();
+
+    running = true;
+    won = false;
+    paused = false;
+    extraLifeAwarded = false;
+    levelTicks = 0;
+    simulationTime = std::chrono::milliseconds(0);
+    lastEnemyUpdate = simulationTime;
+    lastEnemyShoot = simulationTime;
+
+    resetScripts();
 
-    lastEnemyUpdate = std::chrono::steady_clock::now();
-    lastEnemyShoot = std::chrono::steady_clock::now();
+    runRecorded = false;
+    runRank = 0;
 
-    setLevelParameters();
+    // The new run's journal starts with its first tick
+    if (journal) {
+        journal->close();
+    }
 }
 
 void Game::run() {
     renderLevelTransition();
-    std::this_thread::sleep_for(std::chrono::seconds(2));
-
-    while (running) {
-        if (!paused) {
-            // Process input, update game state, and render
-            processInput();
-            update();
-            render();
+    recordScreen();
+    {
+        TraceScope scope("sleep");
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+    }
 
-            // Check for level completion or game over
-            if (checkLevelComplete()) {
-                level++;
-                if (level > 3) {
-                    // Player has won the game
-                    clearScreen();
-                    drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2, "CONGRATULATIONS! YOU WON!", YELLOW);
-                    drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 2, "Final Score: " + std::to_string(player.getScore()), WHITE);
-                    drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 4, "Press any key to exit...", LIGHT_GREY);
-                    _getch();
-                    running = false;
-                }
-                else {
-                    renderLevelTransition();
-                    std::this_thread::sleep_for(std::chrono::seconds(2));
-                    nextLevel();
-                }
-            }
+    // The simulation ticks on a fixed schedule; rendering only happens when the governor asks
+    // for it, and ticks that fell behind are caught up without rendering in between
+    auto nextTick = std::chrono::steady_clock::now();
+    frame.invalidate();
 
-            if (checkGameOver()) {
-                renderGameOver();
-                _getch();
-                running = false;
-            }
-        }
-        else {
+    while (running) {
+        if (paused) {
             // Game is paused, just wait for input
             drawTextAtPosition(POLE_COLS / 2 - 10, POLE_ROWS / 2, "GAME PAUSED", YELLOW);
             drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 2, "Press P to resume", WHITE);
+            recordScreen();
 
             char key = _getch();
             if (key == 'p' || key == 'P') {
                 paused = false;
                 clearScreen();
+                frame.invalidate();
+                governor.restartMeasurement();
+                nextTick = std::chrono::steady_clock::now();
             }
             else if (key == 27) { // ESC key
                 running = false;
             }
+            continue;
+        }
+
+        int ticksRun = 0;
+        while (running && !paused && ticksRun < MAX_CATCH_UP_TICKS && std::chrono::steady_clock::now() >= nextTick) {
+            bool interrupted = runTick();
+            nextTick += std::chrono::milliseconds(tuning->tickMilliseconds);
+            ++ticksRun;
+
+            // Level, win and game over screens wait on their own and draw around the frame; the
+            // schedule restarts after them instead of catching up on the time they were up
+            if (interrupted) {
+                frame.invalidate();
+                governor.restartMeasurement();
+                nextTick = std::chrono::steady_clock::now();
+                break;
+            }
+        }
+
+        // Too far behind to catch up - drop the backlog rather than spiral
+        auto now = std::chrono::steady_clock::now();
+        if (now - nextTick > MAX_CATCH_UP_TICKS * std::chrono::milliseconds(tuning->tickMilliseconds)) {
+            nextTick = now;
+        }
+
+        std::uint64_t tick = static_cast<std::uint64_t>(simulationTime / TICK_DURATION);
+        if (running && !paused && ticksRun > 0 && governor.shouldRender(tick)) {
+            std::size_t allocationsBefore = getAllocationCount();
+            setAllocationsForbidden(assertNoAllocations && levelTicks >= STEADY_STATE_TICKS);
+            render();
+            setAllocationsForbidden(false);
+            tickAllocations += getAllocationCount() - allocationsBefore;
+
+            // Encoding and sending allocate, so spectators are served outside the checked render
+            if (spectators) {
+                TraceScope scope("spectators");
+                AllocationTag tag("spectators");
+                spectators->publish(frame);
+            }
+            recordScreen();
         }
 
-        // Limit frame rate
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Wait for the next tick
+        TraceScope scope("sleep");
+        std::this_thread::sleep_until(nextTick);
     }
 }
 
+// One simulation tick of the interactive game, with level transitions and game over
+// Returns true if a level, win or game over screen held up the game
+bool Game::runTick() {
+    // Everything transient from the previous tick is released here
+    frameArena.reset();
+    startJournal();
+    refreshTuning();
+    std::size_t allocationsBefore = getAllocationCount();
+    auto tickStart = std::chrono::steady_clock::now();
+
+    // Process input and update game state
+    setAllocationsForbidden(assertNoAllocations && levelTicks >= STEADY_STATE_TICKS);
+    processInput();
+    update();
+    if (statePublisher && statePublisher->isOpen()) {
+        publishState();
+    }
+    setAllocationsForbidden(false);
+
+    governor.recordTick(std::chrono::steady_clock::now() - tickStart);
+    tickAllocations = getAllocationCount() - allocationsBefore;
+
+    // Check for level completion or game over
+    if (checkLevelComplete()) {
+        level++;
+        if (!endless && level > SCRIPTED_LEVELS) {
+            // Player has won the game
+            won = true;
+            finishRun();
+            clearScreen();
+            drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2, "CONGRATULATIONS! YOU WON!", YELLOW);
+            drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 2, "Final Score: " + std::to_string(player.getScore()), WHITE);
+            drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 4, "Press any key to exit...", LIGHT_GREY);
+            renderHighScores(POLE_ROWS / 2 + 7);
+            recordScreen();
+            _getch();
+            running = false;
+            return true;
+        }
+        else {
+            renderLevelTransition();
+            recordScreen();
+            {
+                TraceScope scope("sleep");
+                std::this_thread::sleep_for(std::chrono::seconds(2));
+            }
+            nextLevel();
+            return true;
+        }
+    }
+
+    if (checkGameOver()) {
+        finishRun();
+        renderGameOver();
+        recordScreen();
+        _getch();
+        running = false;
+        return true;
+    }
+    return false;
+}
+
 // Process user input
 void Game::processInput() {
+    TraceScope scope("processInput");
+    AllocationTag tag("processInput");
     if (_kbhit()) {
-        char key = _getch();
-        switch (key) {
-        case 'a':
-        case 'A':
-        case 75: // Left arrow
-            player.moveLeft();
-            break;
+        handleKey(_getch());
+    }
 
-        case 'd':
-        case 'D':
-        case 77: // Right arrow
-            player.moveRight();
-            break;
+    // The keyboard still works for pausing and quitting while the autopilot plays
+    if (autopilotEnabled) {
+        handleKey(autopilot.chooseKey(*this));
+    }
+}
 
-        case ' ': // Space bar
-            bullets.push_back(player.shoot());
-            break;
+// Apply a single key press - the one input path for the keyboard and external drivers
+void Game::handleKey(int key) {
+    switch (key) {
+    case 'a':
+    case 'A':
+    case 75: // Left arrow
+        applyShipAction(0, ACTION_LEFT);
+        break;
 
-        case 'p':
-        case 'P':
-            paused = true;
-            break;
+    case 'd':
+    case 'D':
+    case 77: // Right arrow
+        applyShipAction(0, ACTION_RIGHT);
+        break;
+
+    case ' ': // Space bar
+        applyShipAction(0, ACTION_FIRE);
+        break;
+
+    case 'p':
+    case 'P':
+        paused = true;
+        break;
+
+    case 27: // ESC key
+        running = false;
+        break;
+    }
+}
+
+// Translate an action into the key that performs it
+void Game::applyAction(Action action) {
+    switch (action) {
+    case ACTION_LEFT:
+        handleKey('a');
+        break;
+    case ACTION_RIGHT:
+        handleKey('d');
+        break;
+    case ACTION_FIRE:
+        handleKey(' ');
+        break;
+    default:
+        break;
+    }
+}
+
+// Move or fire one ship - 0 is the player, 1 the partner in a two-player game
+void Game::applyShipAction(int ship, Action action) {
+    Player& target = ship == 0 ? player : partner;
+    switch (action) {
+    case ACTION_LEFT:
+        target.moveLeft();
+        break;
+    case ACTION_RIGHT:
+        target.moveRight();
+        break;
+    case ACTION_FIRE: {
+        AllocationTag tag("shoot");
+        bullets.push_back(target.shoot());
+        logEvent(EVENT_PLAYER_SHOT, ship, target.getX(), target.getY(), 0);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Advance the game by one tick without rendering, sleeping or level transition screens
+bool Game::step(Action action, Action partnerAction) {
+    if (!running) {
+        return false;
+    }
 
-        case 27: // ESC key
+    frameArena.reset();
+    startJournal();
+    refreshTuning();
+    setAllocationsForbidden(assertNoAllocations && levelTicks >= STEADY_STATE_TICKS);
+    if (autopilotEnabled) {
+        handleKey(autopilot.chooseKey(*this));
+    }
+    else {
+        applyAction(action);
+    }
+    if (twoPlayers) {
+        applyShipAction(1, partnerAction);
+    }
+    update();
+    setAllocationsForbidden(false);
+
+    if (checkLevelComplete()) {
+        level++;
+        if (!endless && level > SCRIPTED_LEVELS) {
             running = false;
-            break;
+            won = true;
+        }
+        else {
+            nextLevel();
         }
     }
+
+    if (checkGameOver()) {
+        running = false;
+    }
+    if (!running) {
+        finishRun();
+    }
+    return running;
 }
 
 // Update game state
 void Game::update() {
-    auto currentTime = std::chrono::steady_clock::now();
+    TraceScope scope("update");
+    AllocationTag tag("update");
+    ++levelTicks;
+
+    // Large scenes go through the job graph, which ends in exactly the same state
+    if (jobSystem && enemies.size() + bullets.size() >= PARALLEL_TICK_THRESHOLD) {
+        updateParallel();
+        return;
+    }
+
+    simulationTime += TICK_DURATION;
+    auto currentTime = simulationTime;
 
     // Update player
     player.update();
+    if (twoPlayers) {
+        partner.update();
+    }
 
     // Update enemies at intervals based on level
     if (currentTime - lastEnemyUpdate >= enemyUpdateInterval) {
@@ -138,14 +497,21 @@ void Game::update() {
         lastEnemyUpdate = currentTime;
     }
 
+    // Advance enemy and wave scripts every tick
+    updateScripts();
+
     // Handle enemy shooting
     if (currentTime - lastEnemyShoot >= enemyShootInterval) {
         handleEnemyShoot();
         lastEnemyShoot = currentTime;
     }
 
-    // Update bullets
+    // Update bullets and effects
     updateBullets();
+    particles.update();
+
+    // Let opposing shots cancel each other before they hit anything else
+    interceptBullets();
 
     // Check collisions
     checkCollisions();
@@ -153,120 +519,707 @@ void Game::update() {
 
 // Update enemies
 void Game::updateEnemies() {
-    bool shouldMoveDown = false;
+    TraceScope scope("updateEnemies");
+    AllocationTag tag("updateEnemies");
+    // The formation marches as one, so enemies that rejoined it from a script pick up its direction
+    int direction = formationDirection(1);
+    bool shouldMoveDown = formationAtEdge(0, enemies.size(), direction);
+
+    std::array<Bunkers::Row, BUNKER_HEIGHT> occupied{};
+    marchEnemies(0, enemies.size(), direction, shouldMoveDown, occupied);
+    erodeBunkers(&occupied, 1);
+}
 
-    // Check if any enemy is at the edge
-    for (const auto& enemy : enemies) {
-        if (enemy->getX() <= 0 || enemy->getX() >= POLE_COLS - 1) {
-            shouldMoveDown = true;
-            break;
+// Check if any enemy in [begin, end) would reach the edge with this step; turning before it gets
+// there keeps Enemy::update() from bouncing it off the wall a second time and dropping it another row
+// Scripted enemies count where their formation slot is, so they come back to a slot on the field
+bool Game::formationAtEdge(std::size_t begin, std::size_t end, int direction) const {
+    for (std::size_t i = begin; i < end; ++i) {
+        const Enemy& e = asEnemy(enemies[i]);
+        int shift = e.getSlotX() - e.getX();
+        if (e.getLeft() + shift + direction <= 0 || e.getRight() + shift + direction >= POLE_COLS - 1) {
+            return true;
         }
     }
+    return false;
+}
 
-    // Update enemy positions
-    for (auto& enemy : enemies) {
+// Move the enemies in [begin, end) one step and mark the bunker cells they end up on
+void Game::marchEnemies(std::size_t begin, std::size_t end, int direction, bool shouldMoveDown,
+    std::array<Bunkers::Row, BUNKER_HEIGHT>& occupied) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Enemy& e = asEnemy(enemies[i]);
+        if (e.getScriptSlot() < 0) {
+            e.setDirection(shouldMoveDown ? -direction : direction);
+        }
+        else if (shouldMoveDown) {
+            e.setDirection(-e.getDirection());
+        }
         if (shouldMoveDown) {
-            enemy->setDirection(-enemy->getDirection());
-            enemy->setY(enemy->getY() + 1);
+            e.setY(e.getY() + 1);
+        }
+        updateEntity(enemies[i]);
+
+        // Descending enemies chew through whatever bunker cells they occupy
+        if (e.getBottom() < BUNKER_TOP || e.getTop() >= BUNKER_TOP + BUNKER_HEIGHT) {
+            continue;
+        }
+
+        const Sprite* sprite = e.getSprite();
+        if (!sprite) {
+            Bunkers::mark(occupied[e.getY() - BUNKER_TOP], e.getX());
+            continue;
+        }
+        for (int spriteRow = 0; spriteRow < sprite->getHeight(); ++spriteRow) {
+            int row = e.getTop() + spriteRow - BUNKER_TOP;
+            if (row >= 0 && row < BUNKER_HEIGHT) {
+                Bunkers::mark(occupied[row], e.getLeft(), sprite->getMask(spriteRow));
+            }
         }
-        enemy->update();
+    }
+}
+
+// Clear every bunker cell marked in any of the occupancy maps
+void Game::erodeBunkers(const std::array<Bunkers::Row, BUNKER_HEIGHT>* occupied, int count) {
+    for (int row = 0; row < BUNKER_HEIGHT; ++row) {
+        Bunkers::Row merged = occupied[0][row];
+        for (int slice = 1; slice < count; ++slice) {
+            for (int word = 0; word < Bunkers::WORDS; ++word) {
+                merged[word] |= occupied[slice][row][word];
+            }
+        }
+        bunkers.erode(BUNKER_TOP + row, merged);
     }
 }
 
 // Update bullets
 void Game::updateBullets() {
-    // Update bullet positions
-    for (auto& bullet : bullets) {
-        bullet->update();
+    TraceScope scope("updateBullets");
+    AllocationTag tag("updateBullets");
+    moveBullets(0, bullets.size());
+    removeSpentBullets();
+}
+
+// Update bullet positions in [begin, end)
+void Game::moveBullets(std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        bullets[i].update();
     }
+}
 
-    // Remove out-of-bounds bullets
-    bullets.remove_if([](const std::unique_ptr<Bullet>& bullet) {
-        return bullet->isOutOfBounds();
-        });
+// Remove out-of-bounds bullets
+void Game::removeSpentBullets() {
+    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](const Bullet& bullet) {
+        return bullet.isOutOfBounds();
+        }), bullets.end());
 }
 
 // Handle enemy shooting
 void Game::handleEnemyShoot() {
-    std::uniform_int_distribution<> dis(0, enemies.size() - 1);
-
+    TraceScope scope("handleEnemyShoot");
+    AllocationTag tag("handleEnemyShoot");
     // Allow enemies to shoot based on their probability
     for (const auto& enemy : enemies) {
-        if (enemy->shouldShoot()) {
-            bullets.push_back(enemy->shoot());
+        const Enemy& e = asEnemy(enemy);
+        if (e.shouldShoot(gen)) {
+            bullets.push_back(e.shoot());
+            logEvent(EVENT_ENEMY_SHOT, static_cast<int>(enemy.index()), e.getX(), e.getY(), 0);
             // Limit the number of enemy bullets to avoid overwhelming the player
             break;
         }
     }
 }
 
-// Check collisions between game objects
+// Cancel player and enemy bullets that meet in the same column
+// Bullets are counting-sorted by (y, direction) and then stably by column, so every column is
+// a run ordered top to bottom with player bullets first on a shared row. One sweep per column
+// then pairs each enemy bullet with a player bullet on the same cell or one cell above it,
+// which also catches pairs that swapped cells during this tick's move.
+void Game::interceptBullets() {
+    AllocationTag tag("interceptBullets");
+    if (bullets.size() < 2) {
+        return;
+    }
+
+    std::pmr::memory_resource* scratch = frameArena.get();
+    std::size_t count = bullets.size();
+    std::pmr::vector<std::uint32_t> byRow(count, scratch);
+    std::pmr::vector<std::uint32_t> byColumn(count, scratch);
+    std::pmr::vector<std::uint32_t> rowStart(POLE_ROWS * 2 + 1, 0, scratch);
+    std::pmr::vector<std::uint32_t> columnStart(POLE_COLS + 1, 0, scratch);
+    std::pmr::vector<bool> cancelled(count, false, scratch);
+
+    // First pass - order by row, player bullets before enemy bullets on the same row
+    auto rowKey = [](const Bullet& bullet) {
+        return bullet.getY() * 2 + (bullet.getDirection() > 0 ? 1 : 0);
+    };
+    for (const auto& bullet : bullets) {
+        ++rowStart[rowKey(bullet) + 1];
+    }
+    for (int key = 0; key < POLE_ROWS * 2; ++key) {
+        rowStart[key + 1] += rowStart[key];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        byRow[rowStart[rowKey(bullets[i])]++] = static_cast<std::uint32_t>(i);
+    }
+
+    // Second pass - stable by column, keeping the row order inside each column
+    for (const auto& bullet : bullets) {
+        ++columnStart[bullet.getX() + 1];
+    }
+    for (int col = 0; col < POLE_COLS; ++col) {
+        columnStart[col + 1] += columnStart[col];
+    }
+    std::pmr::vector<std::uint32_t> columnFill(columnStart.begin(), columnStart.end() - 1, scratch);
+    for (std::uint32_t index : byRow) {
+        byColumn[columnFill[bullets[index].getX()]++] = index;
+    }
+
+    // Sweep each column top to bottom
+    bool anyCancelled = false;
+    for (int col = 0; col < POLE_COLS; ++col) {
+        std::int64_t pending = -1;  // Last unmatched player bullet in this column
+        for (std::uint32_t k = columnStart[col]; k < columnStart[col + 1]; ++k) {
+            std::uint32_t index = byColumn[k];
+            const Bullet& bullet = bullets[index];
+            if (bullet.getDirection() < 0) {
+                pending = index;
+            }
+            else if (pending >= 0 && bullet.getY() - bullets[pending].getY() <= 1) {
+                cancelled[index] = true;
+                cancelled[pending] = true;
+                pending = -1;
+                anyCancelled = true;
+            }
+        }
+    }
+
+    if (!anyCancelled) {
+        return;
+    }
+
+    // Drop cancelled bullets, keeping the rest in order
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!cancelled[i]) {
+            if (kept != i) {
+                bullets[kept] = std::move(bullets[i]);
+            }
+            ++kept;
+        }
+    }
+    bullets.erase(bullets.begin() + kept, bullets.end());
+}
+
+// Check collisions between game objects. Detection walks the bullets in order and only queues
+// what each one hit; applyCollisionEvents() then changes the scene.
 void Game::checkCollisions() {
-    // Check for collisions between player bullets and enemies
-    auto bulletIt = bullets.begin();
-    while (bulletIt != bullets.end()) {
-        bool bulletHit = false;
-
-        // If it's a player bullet (moving upward)
-        if ((*bulletIt)->getDirection() < 0) {
-            auto enemyIt = enemies.begin();
-            while (enemyIt != enemies.end()) {
-                if ((*bulletIt)->collidesWith(**enemyIt)) {
-                    // Add points to player's score
-                    player.setScore(player.getScore() + (*enemyIt)->getPoints());
-
-                    // Remove enemy and bullet
-                    enemyIt = enemies.erase(enemyIt);
-                    bulletIt = bullets.erase(bulletIt);
-                    bulletHit = true;
+    TraceScope scope("checkCollisions");
+    AllocationTag tag("checkCollisions");
+    beginCollisionEvents();
+
+    for (std::size_t i = 0; i < bullets.size(); ++i) {
+        const Bullet& bullet = bullets[i];
+        std::uint32_t index = static_cast<std::uint32_t>(i);
+
+        // Bunkers stop bullets from either side and lose the cell that was hit
+        if (claimBunkerCell(bullet.getX(), bullet.getY())) {
+            collisionEvents.push(GAME_EVENT_BUNKER_HIT, index, NO_EVENT_INDEX, bullet.getX(), bullet.getY(), 0);
+        }
+        // A player bullet (moving upward) takes the first enemy it overlaps
+        else if (bullet.getDirection() < 0) {
+            for (std::size_t e = 0; e < enemies.size(); ++e) {
+                const Enemy& enemy = asEnemy(enemies[e]);
+                if (bullet.collidesWith(enemy) && !killed[e]) {
+                    killed[e] = 1;
+                    collisionEvents.push(GAME_EVENT_ENEMY_KILLED, index, static_cast<std::uint32_t>(e),
+                        enemy.getX(), enemy.getY(), enemy.getPoints());
                     break;
                 }
-                else {
-                    ++enemyIt;
-                }
             }
         }
-        // If it's an enemy bullet (moving downward)
-        else if ((*bulletIt)->getDirection() > 0) {
-            if ((*bulletIt)->collidesWith(player)) {
-                // Player is hit, lose a life
-                player.setLives(player.getLives() - 1);
-
-                // Remove bullet
-                bulletIt = bullets.erase(bulletIt);
-                bulletHit = true;
+        // An enemy bullet (moving downward) hits a ship
+        else if (bullet.getDirection() > 0) {
+            int ship = shipHitBy(bullet);
+            if (ship >= 0) {
+                const Player& target = ship == 0 ? player : partner;
+                collisionEvents.push(GAME_EVENT_PLAYER_HIT, index, ship, target.getX(), target.getY(), 0);
             }
         }
+    }
 
-        if (!bulletHit) {
-            ++bulletIt;
-        }
+    detectInvasion();
+    applyCollisionEvents();
+}
+
+// Ship an enemy bullet hits - 0 the player, 1 the partner, -1 neither
+int Game::shipHitBy(const Bullet& bullet) const {
+    if (bullet.collidesWith(player)) {
+        return 0;
+    }
+    if (twoPlayers && bullet.collidesWith(partner)) {
+        return 1;
     }
+    return -1;
+}
 
-    // Check if any enemy has reached the player's level
-    for (const auto& enemy : enemies) {
-        if (enemy->getY() >= player.getY()) {
-            player.setLives(0); // Game over if enemies reach the bottom
+// Reset what detection has found and claimed, for a new tick
+void Game::beginCollisionEvents() {
+    collisionEvents.clear();
+    bunkerHits = {};
+    killed.assign(enemies.size(), 0);
+}
+
+// A bullet at (x, y) stops on a solid bunker cell no earlier bullet has taken this tick
+bool Game::claimBunkerCell(int x, int y) {
+    if (!bunkers.contains(x, y) || Bunkers::marked(bunkerHits[y - BUNKER_TOP], x)) {
+        return false;
+    }
+    Bunkers::mark(bunkerHits[y - BUNKER_TOP], x);
+    return true;
+}
+
+// Queue an invasion if any enemy still standing has got down to the player
+void Game::detectInvasion() {
+    for (std::size_t e = 0; e < enemies.size(); ++e) {
+        if (!killed[e] && asEnemy(enemies[e]).getBottom() >= player.getTop()) {
+            collisionEvents.push(GAME_EVENT_INVASION, NO_EVENT_INDEX, static_cast<std::uint32_t>(e), 0, 0, 0);
             break;
         }
     }
+}
 
-    // Check for awarded extra lives (at 300 points)
-    static bool extraLifeAwarded = false;
-    if (player.getScore() >= 300 && !extraLifeAwarded) {
-        player.setLives(player.getLives() + 1);
+// Apply the tick's collision events, one batched pass per concern. The passes that draw random
+// numbers or write the journal keep queue order, so a run plays out as it always has.
+void Game::applyCollisionEvents() {
+    TraceScope scope("applyCollisionEvents");
+    applyBunkerHits();
+    applyScoring();
+    applyLives();
+    spawnHitEffects();
+    journalCollisionEvents();
+    removeHitObjects();
+}
+
+// Clear every claimed bunker cell, a row at a time
+void Game::applyBunkerHits() {
+    if (collisionEvents.count(GAME_EVENT_BUNKER_HIT) == 0) {
+        return;
+    }
+    for (int row = 0; row < BUNKER_HEIGHT; ++row) {
+        bunkers.erode(BUNKER_TOP + row, bunkerHits[row]);
+    }
+}
+
+// Add the points of every enemy killed
+void Game::applyScoring() {
+    if (collisionEvents.count(GAME_EVENT_ENEMY_KILLED) == 0) {
+        return;
+    }
+    int points = 0;
+    for (const GameEvent& event : collisionEvents) {
+        if (event.type == GAME_EVENT_ENEMY_KILLED) {
+            points += event.value;
+        }
+    }
+    player.setScore(player.getScore() + points);
+}
+
+// Take a life per hit (never below zero), all of them on an invasion, then award the extra life
+void Game::applyLives() {
+    int lives = player.getLives();
+    for (GameEvent& event : collisionEvents) {
+        if (event.type == GAME_EVENT_PLAYER_HIT) {
+            lives = std::max(0, lives - 1);
+            event.value = lives;
+        }
+        else if (event.type == GAME_EVENT_INVASION) {
+            lives = 0;
+        }
+    }
+
+    // Extra life once the score is high enough (300 points unless tuned)
+    if (player.getScore() >= tuning->extraLifeScore && !extraLifeAwarded) {
+        ++lives;
         extraLifeAwarded = true;
+        collisionEvents.push(GAME_EVENT_EXTRA_LIFE, NO_EVENT_INDEX, NO_EVENT_INDEX, player.getX(), player.getY(), lives);
     }
+    player.setLives(lives);
+}
+
+// Explosions where bullets stopped, enemies died and the player was hit
+void Game::spawnHitEffects() {
+    for (const GameEvent& event : collisionEvents) {
+        switch (event.type) {
+        case GAME_EVENT_BUNKER_HIT:
+            particles.explode(event.x, event.y, 3, 0.5f);
+            break;
+        case GAME_EVENT_ENEMY_KILLED:
+            particles.explode(event.x, event.y, 12, 1.2f);
+            break;
+        case GAME_EVENT_PLAYER_HIT:
+            particles.explode(event.x, event.y, 40, 1.8f);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// Write kills, hits and the extra life to the run's journal
+void Game::journalCollisionEvents() {
+    if (!journal) {
+        return;
+    }
+    for (const GameEvent& event : collisionEvents) {
+        switch (event.type) {
+        case GAME_EVENT_ENEMY_KILLED:
+            logEvent(EVENT_KILL, static_cast<int>(enemies[event.target].index()), event.x, event.y, event.value);
+            break;
+        case GAME_EVENT_PLAYER_HIT:
+            logEvent(EVENT_PLAYER_HIT, static_cast<int>(event.target), event.x, event.y, event.value);
+            break;
+        case GAME_EVENT_EXTRA_LIFE:
+            logEvent(EVENT_EXTRA_LIFE, 0, event.x, event.y, event.value);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// Drop the bullets that stopped and the enemies that died, keeping the rest in order
+void Game::removeHitObjects() {
+    std::size_t hits = collisionEvents.size() - collisionEvents.count(GAME_EVENT_INVASION)
+        - collisionEvents.count(GAME_EVENT_EXTRA_LIFE);
+    if (hits == 0) {
+        return;
+    }
+
+    spent.assign(bullets.size(), 0);
+    for (const GameEvent& event : collisionEvents) {
+        if (event.bullet != NO_EVENT_INDEX) {
+            spent[event.bullet] = 1;
+        }
+    }
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < bullets.size(); ++i) {
+        if (!spent[i]) {
+            if (kept != i) {
+                bullets[kept] = std::move(bullets[i]);
+            }
+            ++kept;
+        }
+    }
+    bullets.erase(bullets.begin() + kept, bullets.end());
+
+    if (collisionEvents.count(GAME_EVENT_ENEMY_KILLED) == 0) {
+        return;
+    }
+    std::size_t survivors = 0;
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        if (killed[i]) {
+            releaseScript(asEnemy(enemies[i]));
+        }
+        else {
+            if (survivors != i) {
+                enemies[survivors] = std::move(enemies[i]);
+            }
+            ++survivors;
+        }
+    }
+    enemies.erase(enemies.begin() + survivors, enemies.end());
+}
+
+// Parallel tick - the same steps as update(), cut into jobs:
+//   march scan (per slice) -> march (per slice) -> bunker erosion -> scripts -> enemy fire
+//   -> bullet movement (per range) -> bullet cleanup -> interception -> bullet row sort
+//   -> broad phase (per row band, also after the enemy row index) -> collision resolution
+// Particles update on their own and only have to finish before collisions spawn new ones.
+// Anything that draws random numbers or mutates shared state in order runs as a single job,
+// and per-slice results are merged in slice order, so the result matches the serial tick.
+void Game::buildTickGraph() {
+    auto addParts = [this](JobGraph::Function function) {
+        std::vector<int> ids;
+        for (int part = 0; part < tickParts; ++part) {
+            ids.push_back(tickGraph.add(function, this, part));
+        }
+        return ids;
+    };
+    auto after = [this](const std::vector<int>& before, int job) {
+        for (int id : before) {
+            tickGraph.addDependency(id, job);
+        }
+    };
+    std::vector<int> scan = addParts([](void* context, int part) {
+        Game* game = static_cast<Game*>(context);
+        if (game->enemyTick) {
+            std::size_t count = game->enemies.size();
+            game->sliceAtEdge[part] = game->formationAtEdge(count * part / game->tickParts,
+                count * (part + 1) / game->tickParts, game->marchDirection);
+        }
+        });
+    std::vector<int> march = addParts([](void* context, int part) {
+        Game* game = static_cast<Game*>(context);
+        game->sliceOccupied[part] = {};
+        if (game->enemyTick) {
+            bool shouldMoveDown = std::find(game->sliceAtEdge.begin(), game->sliceAtEdge.end(), 1) != game->sliceAtEdge.end();
+            std::size_t count = game->enemies.size();
+            game->marchEnemies(count * part / game->tickParts, count * (part + 1) / game->tickParts,
+                game->marchDirection, shouldMoveDown, game->sliceOccupied[part]);
+        }
+        });
+    int erode = tickGraph.add([](void* context, int) {
+        Game* game = static_cast<Game*>(context);
+        if (game->enemyTick) {
+            game->erodeBunkers(game->sliceOccupied.data(), game->tickParts);
+        }
+        }, this);
+    int scripts = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->updateScripts();
+        }, this);
+    int shoot = tickGraph.add([](void* context, int) {
+        Game* game = static_cast<Game*>(context);
+        if (game->shootTick) {
+            game->handleEnemyShoot();
+        }
+        }, this);
+    std::vector<int> moveBullets = addParts([](void* context, int part) {
+        Game* game = static_cast<Game*>(context);
+        std::size_t count = game->bullets.size();
+        game->moveBullets(count * part / game->tickParts, count * (part + 1) / game->tickParts);
+        });
+    int spent = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->removeSpentBullets();
+        }, this);
+    int intercept = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->interceptBullets();
+        }, this);
+    int sortBullets = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->sortBulletsByRow();
+        }, this);
+    int indexEnemies = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->indexEnemyRows();
+        }, this);
+    std::vector<int> broadPhase = addParts([](void* context, int part) {
+        static_cast<Game*>(context)->findCollisionCandidates(part);
+        });
+    int particlesJob = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->particles.update();
+        }, this);
+    int resolve = tickGraph.add([](void* context, int) {
+        static_cast<Game*>(context)->resolveCollisions();
+        }, this);
+
+    for (int id : march) {
+        after(scan, id);
+    }
+    after(march, erode);
+    tickGraph.addDependency(erode, scripts);
+    tickGraph.addDependency(scripts, shoot);
+    tickGraph.addDependency(scripts, indexEnemies);
+    for (int id : moveBullets) {
+        tickGraph.addDependency(shoot, id);
+    }
+    after(moveBullets, spent);
+    tickGraph.addDependency(spent, intercept);
+    tickGraph.addDependency(intercept, sortBullets);
+    for (int id : broadPhase) {
+        tickGraph.addDependency(sortBullets, id);
+        tickGraph.addDependency(indexEnemies, id);
+    }
+    after(broadPhase, resolve);
+    tickGraph.addDependency(particlesJob, resolve);
+}
+
+// Run one tick through the job graph
+void Game::updateParallel() {
+    simulationTime += TICK_DURATION;
+    auto currentTime = simulationTime;
+
+    player.update();
+    if (twoPlayers) {
+        partner.update();
+    }
+
+    // Timers and the march direction are settled up front, so the jobs only read them
+    enemyTick = currentTime - lastEnemyUpdate >= enemyUpdateInterval;
+    if (enemyTick) {
+        lastEnemyUpdate = currentTime;
+        marchDirection = formationDirection(1);
+        std::fill(sliceAtEdge.begin(), sliceAtEdge.end(), 0);
+    }
+    shootTick = currentTime - lastEnemyShoot >= enemyShootInterval;
+    if (shootTick) {
+        lastEnemyShoot = currentTime;
+    }
+
+    jobSystem->run(tickGraph);
+}
+
+// Counting-sort bullet indices by row, so each broad phase band finds its bullets directly
+void Game::sortBulletsByRow() {
+    bulletRowStart.assign(POLE_ROWS + 1, 0);
+    for (const auto& bullet : bullets) {
+        ++bulletRowStart[bullet.getY() + 1];
+    }
+    for (int row = 0; row < POLE_ROWS; ++row) {
+        bulletRowStart[row + 1] += bulletRowStart[row];
+    }
+
+    bulletsByRow.resize(bullets.size());
+    bulletRowFill.assign(bulletRowStart.begin(), bulletRowStart.end() - 1);
+    for (std::size_t i = 0; i < bullets.size(); ++i) {
+        bulletsByRow[bulletRowFill[bullets[i].getY()]++] = static_cast<std::uint32_t>(i);
+    }
+
+    candidateBegin.resize(bullets.size());
+    candidateEnd.resize(bullets.size());
+}
+
+// List the enemies covering each row, in enemy order
+void Game::indexEnemyRows() {
+    auto rowsOf = [](const Enemy& enemy, int& top, int& bottom) {
+        top = std::max(enemy.getTop(), 0);
+        bottom = std::min(enemy.getBottom(), POLE_ROWS - 1);
+    };
+
+    enemyRowStart.assign(POLE_ROWS + 1, 0);
+    for (const auto& entity : enemies) {
+        int top, bottom;
+        rowsOf(asEnemy(entity), top, bottom);
+        for (int row = top; row <= bottom; ++row) {
+            ++enemyRowStart[row + 1];
+        }
+    }
+    for (int row = 0; row < POLE_ROWS; ++row) {
+        enemyRowStart[row + 1] += enemyRowStart[row];
+    }
+
+    enemyRowList.resize(enemyRowStart[POLE_ROWS]);
+    enemyRowFill.assign(enemyRowStart.begin(), enemyRowStart.end() - 1);
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        int top, bottom;
+        rowsOf(asEnemy(enemies[i]), top, bottom);
+        for (int row = top; row <= bottom; ++row) {
+            enemyRowList[enemyRowFill[row]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+}
+
+// Broad phase for the bullets in one band of rows - record what each bullet touches, change nothing.
+// Player bullets get every enemy they overlap, in enemy order; enemy bullets get PLAYER_CANDIDATE
+// or PARTNER_CANDIDATE when they overlap a ship.
+void Game::findCollisionCandidates(int part) {
+    std::vector<std::uint32_t>& found = candidates[part];
+    found.clear();
+
+    int firstRow = POLE_ROWS * part / tickParts;
+    int lastRow = POLE_ROWS * (part + 1) / tickParts;
+    for (std::uint32_t k = bulletRowStart[firstRow]; k < bulletRowStart[lastRow]; ++k) {
+        std::uint32_t index = bulletsByRow[k];
+        const Bullet& bullet = bullets[index];
+        candidateBegin[index] = static_cast<std::uint32_t>(found.size());
+
+        if (bullet.getDirection() < 0) {
+            int row = bullet.getY();
+            for (std::uint32_t e = enemyRowStart[row]; e < enemyRowStart[row + 1]; ++e) {
+                if (bullet.collidesWith(asEnemy(enemies[enemyRowList[e]]))) {
+                    found.push_back(enemyRowList[e]);
+                }
+            }
+        }
+        else if (bullet.getDirection() > 0) {
+            int ship = shipHitBy(bullet);
+            if (ship >= 0) {
+                found.push_back(ship == 0 ? PLAYER_CANDIDATE : PARTNER_CANDIDATE);
+            }
+        }
+
+        candidateEnd[index] = static_cast<std::uint32_t>(found.size());
+    }
+}
+
+// Queue the broad phase results in bullet order, exactly as checkCollisions() would, and apply them
+void Game::resolveCollisions() {
+    TraceScope scope("resolveCollisions");
+    AllocationTag tag("resolveCollisions");
+    beginCollisionEvents();
+
+    for (std::size_t i = 0; i < bullets.size(); ++i) {
+        const Bullet& bullet = bullets[i];
+        const std::vector<std::uint32_t>& found = candidates[bandOfRow(bullet.getY())];
+        std::uint32_t index = static_cast<std::uint32_t>(i);
+
+        if (claimBunkerCell(bullet.getX(), bullet.getY())) {
+            collisionEvents.push(GAME_EVENT_BUNKER_HIT, index, NO_EVENT_INDEX, bullet.getX(), bullet.getY(), 0);
+        }
+        else if (bullet.getDirection() < 0) {
+            // The first enemy it overlaps that an earlier bullet hasn't already taken
+            for (std::uint32_t k = candidateBegin[i]; k < candidateEnd[i]; ++k) {
+                std::uint32_t e = found[k];
+                if (!killed[e]) {
+                    const Enemy& enemy = asEnemy(enemies[e]);
+                    killed[e] = 1;
+                    collisionEvents.push(GAME_EVENT_ENEMY_KILLED, index, e, enemy.getX(), enemy.getY(), enemy.getPoints());
+                    break;
+                }
+            }
+        }
+        else if (bullet.getDirection() > 0 && candidateEnd[i] > candidateBegin[i]) {
+            int ship = found[candidateBegin[i]] == PLAYER_CANDIDATE ? 0 : 1;
+            const Player& target = ship == 0 ? player : partner;
+            collisionEvents.push(GAME_EVENT_PLAYER_HIT, index, ship, target.getX(), target.getY(), 0);
+        }
+    }
+
+    detectInvasion();
+    applyCollisionEvents();
+}
+
+// Broad phase band a row belongs to - the last band starting at or above it
+int Game::bandOfRow(int row) const {
+    int part = row * tickParts / POLE_ROWS;
+    while (part + 1 < tickParts && POLE_ROWS * (part + 1) / tickParts <= row) {
+        ++part;
+    }
+    while (part > 0 && POLE_ROWS * part / tickParts > row) {
+        --part;
+    }
+    return part;
+}
+
+// Marching direction of the enemies still in formation. Scripted enemies march along with their
+// slots, so when every enemy is out on a script theirs is the formation's; fallback if there are none.
+int Game::formationDirection(int fallback) const {
+    for (const auto& entity : enemies) {
+        const Enemy& enemy = asEnemy(entity);
+        if (enemy.getScriptSlot() < 0) {
+            return enemy.getDirection();
+        }
+    }
+    return enemies.empty() ? fallback : asEnemy(enemies.front()).getDirection();
 }
 
 // Initialize enemies
 void Game::initializeEnemies() {
+    AllocationTag tag("initializeEnemies");
     enemies.clear();
+    enemies.reserve(enemyRows * enemyCols + 1);
+    killed.reserve(enemies.capacity());
+    if (jobSystem) {
+        enemyRowList.reserve(enemies.capacity() * SPRITE_MAX_HEIGHT);
+    }
 
     // Calculate spacing between enemies
     int startX = (POLE_COLS - (enemyCols * 3)) / 2;
     int startY = 5;
 
+    // From level 2 on a boss leads the formation from above
+    if (level >= 2) {
+        enemies.emplace_back(std::in_place_type<EnemyBoss>, POLE_COLS / 2, startY - 3);
+    }
+
     for (int row = 0; row < enemyRows; ++row) {
         for (int col = 0; col < enemyCols; ++col) {
             int x = startX + col * 3;
@@ -274,52 +1227,257 @@ void Game::initializeEnemies() {
 
             // Create different types of enemies based on row
             if (row == 0) {
-                enemies.push_back(std::make_unique<EnemyType4>(x, y));
+                enemies.emplace_back(std::in_place_type<EnemyType4>, x, y);
             }
             else if (row == 1) {
-                enemies.push_back(std::make_unique<EnemyType3>(x, y));
+                enemies.emplace_back(std::in_place_type<EnemyType3>, x, y);
             }
             else if (row == 2 || row == 3) {
-                enemies.push_back(std::make_unique<EnemyType2>(x, y));
+                enemies.emplace_back(std::in_place_type<EnemyType2>, x, y);
             }
             else {
-                enemies.push_back(std::make_unique<EnemyType1>(x, y));
+                enemies.emplace_back(std::in_place_type<EnemyType1>, x, y);
             }
         }
     }
 }
 
+// Drop all enemy scripts and start the wave script for the current level
+void Game::resetScripts() {
+    enemyScripts.clear();
+    enemyScriptArgs.clear();
+    freeScriptSlots.clear();
+    waveScript = standardWave(scriptPool, level);
+    waveLevel = level;
+}
+
+// Advance the wave script and every enemy script by one tick
+void Game::updateScripts() {
+    AllocationTag tag("updateScripts");
+    WaveStep waveStep;
+    if (waveScript.tick(waveStep) && waveStep.order != WAVE_IDLE) {
+        launchScripts(waveStep);
+    }
+
+    for (auto& entity : enemies) {
+        Enemy& enemy = asEnemy(entity);
+        if (enemy.getScriptSlot() < 0) {
+            continue;
+        }
+
+        EnemyStep step;
+        if (!enemyScripts[enemy.getScriptSlot()].tick(step)) {
+            // Script finished, the enemy goes back to plain formation marching; anything still
+            // held back puts it straight onto its slot
+            enemy.setX(enemy.getX() + enemy.getHeldX());
+            enemy.setY(enemy.getY() + enemy.getHeldY());
+            releaseScript(enemy);
+            continue;
+        }
+
+        // Keep two columns of room on both sides: the formation march still moves it one more
+        // step, and Enemy::update() would turn it around at the edge column, away from its slot.
+        // What the edges hold back is made up as soon as the path turns away from them, so a
+        // script ends on the formation slot it started from
+        int minX = 2 + enemy.getX() - enemy.getLeft();
+        int maxX = POLE_COLS - 3 - (enemy.getRight() - enemy.getX());
+        int x = enemy.getX() + step.dx + enemy.getHeldX();
+        int y = enemy.getY() + step.dy + enemy.getHeldY();
+        enemy.setX(std::clamp(x, minX, maxX));
+        enemy.setY(std::max(0, y));
+        enemy.setPath(enemy.getPathX() + step.dx, enemy.getPathY() + step.dy);
+        enemy.setHeld(x - enemy.getX(), y - enemy.getY());
+        if (step.fire) {
+            bullets.push_back(enemy.shoot());
+            logEvent(EVENT_ENEMY_SHOT, static_cast<int>(entity.index()), enemy.getX(), enemy.getY(), 0);
+        }
+    }
+}
+
+// Hand a behaviour from the wave script to randomly picked enemies still in formation
+void Game::launchScripts(const WaveStep& step) {
+    AllocationTag tag("launchScripts");
+    if (enemies.empty()) {
+        return;
+    }
+
+    std::uniform_int_distribution<std::size_t> pick(0, enemies.size() - 1);
+    for (int i = 0; i < step.count; ++i) {
+        Enemy& enemy = asEnemy(enemies[pick(gen)]);
+        if (enemy.getScriptSlot() >= 0) {
+            continue;
+        }
+
+        EnemyScriptArgs args;
+        args.order = step.order;
+        if (step.order == WAVE_SWOOP) {
+            // Stay well clear of the player's row, which would end the game
+            args.depth = std::min(12, player.getTop() - enemy.getBottom() - 4);
+            if (args.depth <= 0) {
+                continue;
+            }
+        }
+        else if (step.order == WAVE_DIVE) {
+            // Alternate between the two dive shapes, skipping enemies too low for the path to fit
+            args.path = (i % 2 == 0) ? &DIVE_HOOK : &DIVE_PLUNGE;
+            int depth = (i % 2 == 0) ? divePathDepth(DIVE_HOOK) : divePathDepth(DIVE_PLUNGE);
+            if (enemy.getBottom() + depth >= player.getTop() - 4) {
+                continue;
+            }
+
+            // Loop out towards the nearer wall, then come down on the player's column
+            args.mirror = enemy.getX() < POLE_COLS / 2 ? -1 : 1;
+            args.aim = std::clamp(player.getX() - enemy.getX(), -60, 60);
+        }
+        else {
+            args.order = WAVE_STRAFE;
+            args.width = 6;
+            args.passes = 4;
+        }
+
+        EnemyScript script = startEnemyScript(scriptPool, args);
+        // The frame pool is exhausted - leave this enemy in formation
+        if (!script.isRunning()) {
+            continue;
+        }
+
+        int slot;
+        if (!freeScriptSlots.empty()) {
+            slot = freeScriptSlots.back();
+            freeScriptSlots.pop_back();
+            enemyScripts[slot] = std::move(script);
+            enemyScriptArgs[slot] = args;
+        }
+        else {
+            slot = static_cast<int>(enemyScripts.size());
+            enemyScripts.push_back(std::move(script));
+            enemyScriptArgs.push_back(args);
+        }
+        enemy.setScriptSlot(slot);
+    }
+}
+
+// Stop the script driving an enemy and recycle its slot
+void Game::releaseScript(Enemy& enemy) {
+    int slot = enemy.getScriptSlot();
+    if (slot < 0) {
+        return;
+    }
+
+    enemyScripts[slot] = EnemyScript();
+    enemyScriptArgs[slot] = EnemyScriptArgs();
+    freeScriptSlots.push_back(slot);
+    enemy.setScriptSlot(-1);
+    enemy.setPath(0, 0);
+    enemy.setHeld(0, 0);
+}
+
 // Render the game
 void Game::render() const {
+    TraceScope scope("render");
+    AllocationTag tag("render");
+    auto drawStart = std::chrono::steady_clock::now();
+
+    // Draw everything into the frame, then put it on screen in one write
+    drawFrame();
+
+    auto presentStart = std::chrono::steady_clock::now();
+    {
+        TraceScope scope("present");
+        if (virtualTerminal) {
+            frame.presentAnsi(*ansiStyle, governor.useDiffOutput());
+        }
+        else if (governor.useDiffOutput()) {
+            frame.presentChanges();
+        }
+        else {
+            frame.present();
+        }
+    }
+    auto presentEnd = std::chrono::steady_clock::now();
+
+    governor.recordFrame(presentStart - drawStart, presentEnd - presentStart);
+}
+
+// Draw the current state into the frame without touching the console
+const Frame& Game::drawFrame() const {
+    setRenderTarget(&frame);
     clearScreen();
 
+    // Render bunkers
+    bunkers.render();
+
+    // Render effects underneath the game objects - the first thing to go on a slow console
+    if (governor.drawDecorations()) {
+        particles.render();
+    }
+
     // Render player
     player.render();
+    if (twoPlayers) {
+        partner.render();
+    }
 
     // Render enemies
     for (const auto& enemy : enemies) {
-        enemy->render();
+        renderEntity(enemy);
     }
 
     // Render bullets
     for (const auto& bullet : bullets) {
-        bullet->render();
+        bullet.render();
     }
 
     // Render status bar
     renderStatusBar();
+
+    setRenderTarget(nullptr);
+    return frame;
 }
 
 // Render status bar
 void Game::renderStatusBar() const {
-    std::string statusText = "Score: " + std::to_string(player.getScore()) +
-        " | Lives: " + std::to_string(player.getLives()) +
-        " | Level: " + std::to_string(level);
+    AllocationTag tag("renderStatusBar");
+    std::pmr::string statusText(frameArena.get());
+    statusText += "Score: ";
+    appendNumber(statusText, player.getScore());
+    statusText += " | Lives: ";
+    appendNumber(statusText, player.getLives());
+    statusText += " | Level: ";
+    appendNumber(statusText, level);
+    if (tuningWatcher && tuningWatcher->hasError()) {
+        statusText += " | Tuning file not applied";
+    }
+    if (scores) {
+        statusText += " | Best: ";
+        appendNumber(statusText, std::max(bestScore, player.getScore()));
+    }
+
+    // What the frame governor is aiming for and what it measured
+    statusText += " | FPS: ";
+    appendNumber(statusText, governor.getTargetFps());
+    statusText += " (";
+    statusText += governor.getQualityName();
+    statusText += ") | Tick: ";
+    appendMilliseconds(statusText, governor.getTickMs());
+    statusText += " | Draw: ";
+    appendMilliseconds(statusText, governor.getDrawMs());
+    statusText += " | Present: ";
+    appendMilliseconds(statusText, governor.getPresentMs());
+
+    if (ALLOCATION_COUNTING) {
+        statusText += " | Allocs/tick: ";
+        appendNumber(statusText, static_cast<int>(tickAllocations));
+    }
+    if (!statusNote.empty()) {
+        statusText += " | ";
+        statusText += statusNote;
+    }
 
     drawTextAtPosition(2, POLE_ROWS - 2, statusText, WHITE);
 
     // Instructions
-    std::string instructions = "A/D: Move | Space: Shoot | P: Pause | ESC: Exit";
+    std::string_view instructions = "A/D: Move | Space: Shoot | P: Pause | ESC: Exit";
     drawTextAtPosition(POLE_COLS - instructions.length() - 2, POLE_ROWS - 2, instructions, LIGHT_GREY);
 }
 
@@ -330,12 +1488,38 @@ void Game::renderGameOver() const {
     drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2, "Final Score: " + std::to_string(player.getScore()), WHITE);
     drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 2, "Level Reached: " + std::to_string(level), WHITE);
     drawTextAtPosition(POLE_COLS / 2 - 15, POLE_ROWS / 2 + 4, "Press any key to exit...", LIGHT_GREY);
+    renderHighScores(POLE_ROWS / 2 + 7);
+}
+
+// Render the best runs on record and where this one placed
+void Game::renderHighScores(int row) const {
+    if (!scores || !scores->isOpen()) {
+        return;
+    }
+    std::string rankText = runRank > 0 ? "This run ranks #" + std::to_string(runRank) : "Your best: " + std::to_string(bestScore);
+    drawTextAtPosition(POLE_COLS / 2 - 15, row, "HIGH SCORES    " + rankText, YELLOW);
+    int position = 1;
+    for (const ScoreRecord& record : scores->top(5)) {
+        std::string line = std::to_string(position) + ". " + scorePlayerName(record);
+        line.resize(std::max<std::size_t>(line.size() + 1, 22), ' ');
+        line += std::to_string(record.score) + "  L" + std::to_string(record.level) + (record.won ? "  won" : "");
+        drawTextAtPosition(POLE_COLS / 2 - 15, row + position, line, position == runRank ? GREEN : WHITE);
+        ++position;
+    }
 }
 
 // Render level transition
 void Game::renderLevelTransition() const {
     clearScreen();
 
+    if (isGeneratedLevel(level)) {
+        std::string waveMsg = "Endless Wave " + std::to_string(level);
+        std::string difficultyMsg = "Difficulty: " + std::to_string(static_cast<int>(waveDifficulty(level) * 100)) + "%";
+        drawTextAtPosition(POLE_COLS / 2 - waveMsg.length() / 2, POLE_ROWS / 2, waveMsg, YELLOW);
+        drawTextAtPosition(POLE_COLS / 2 - difficultyMsg.length() / 2, POLE_ROWS / 2 + 2, difficultyMsg, WHITE);
+        return;
+    }
+
     std::string levelMsg = levelMessages.at(level);
     drawTextAtPosition(POLE_COLS / 2 - levelMsg.length() / 2, POLE_ROWS / 2, levelMsg, YELLOW);
 
@@ -350,6 +1534,90 @@ void Game::renderLevelTransition() const {
     }
 }
 
+// Open the journal of a run on its first tick, so a game reset before it plays leaves no file
+// Every run gets its own journal, named after its seed
+void Game::startJournal() {
+    if (journal && !journal->isOpen()) {
+        AllocationTag tag("startJournal");
+        std::string path = journalDirectory + "/journal_" + std::to_string(waveSeed) + ".evj";
+        if (!journal->open(path, waveSeed)) {
+            // Tried once - the rest of the session goes without a journal rather than retrying every tick
+            std::cerr << "Could not write journal " << path << "; journaling is off" << std::endl;
+            journal.reset();
+            return;
+        }
+        logEvent(EVENT_LEVEL_START, 0, player.getX(), player.getY(), level);
+    }
+}
+
+// Append an event to the run's journal, stamped with the tick and level
+void Game::logEvent(EventKind kind, int subject, int x, int y, int value) {
+    if (journal) {
+        journal->record(kind, static_cast<std::uint32_t>(simulationTime / TICK_DURATION), level, subject, x, y, value);
+    }
+}
+
+// Append the finished run to the high-score table, once per run
+void Game::finishRun() {
+    if (!scores || runRecorded) {
+        return;
+    }
+    runRecorded = true;
+    AllocationTag tag("finishRun");
+    // Winning moves the level past the last one
+    runRank = scores->append(playerName, player.getScore(), won ? level - 1 : level, waveSeed,
+        static_cast<std::uint32_t>(simulationTime / TICK_DURATION), won);
+    bestScore = std::max(bestScore, player.getScore());
+}
+
+// Record what the console shows now, if a recording is running
+void Game::recordScreen() {
+    if (recorder) {
+        TraceScope scope("record");
+        AllocationTag tag("record");
+        recorder->capture();
+    }
+}
+
+// Publish the tick - written straight into the shared slot, so the only copy is the frame's cells
+void Game::publishState() {
+    static_assert(SHARED_STATE_ROWS == POLE_ROWS && SHARED_STATE_COLS == POLE_COLS, "shared state must match the playing field");
+    TraceScope scope("publishState");
+
+    SharedState& state = statePublisher->begin();
+    state.level = level;
+    state.score = player.getScore();
+    state.lives = player.getLives();
+    state.playerX = static_cast<std::int16_t>(player.getX());
+    state.playerY = static_cast<std::int16_t>(player.getY());
+
+    state.enemyTotal = static_cast<std::uint32_t>(enemies.size());
+    state.enemyCount = std::min<std::uint32_t>(state.enemyTotal, SHARED_MAX_ENEMIES);
+    for (std::uint32_t i = 0; i < state.enemyCount; ++i) {
+        const Enemy& enemy = asEnemy(enemies[i]);
+        state.enemies[i] = SharedObject{ static_cast<std::int16_t>(enemy.getX()), static_cast<std::int16_t>(enemy.getY()),
+            static_cast<std::uint8_t>(enemies[i].index()), static_cast<std::int8_t>(enemy.getDirection()),
+            enemy.getSymbol(), static_cast<std::uint8_t>(enemy.getColor()) };
+    }
+
+    state.bulletTotal = static_cast<std::uint32_t>(bullets.size());
+    state.bulletCount = std::min<std::uint32_t>(state.bulletTotal, SHARED_MAX_BULLETS);
+    for (std::uint32_t i = 0; i < state.bulletCount; ++i) {
+        const Bullet& bullet = bullets[i];
+        state.bullets[i] = SharedObject{ static_cast<std::int16_t>(bullet.getX()), static_cast<std::int16_t>(bullet.getY()),
+            static_cast<std::uint8_t>(bullet.getDirection() < 0 ? 0 : 1), static_cast<std::int8_t>(bullet.getDirection()),
+            bullet.getSymbol(), static_cast<std::uint8_t>(bullet.getColor()) };
+    }
+
+    const Cell* cells = frame.data();
+    for (int i = 0; i < POLE_ROWS * POLE_COLS; ++i) {
+        state.glyphs[i] = cells[i].glyph;
+        state.colors[i] = static_cast<std::uint8_t>(cells[i].color);
+    }
+
+    statePublisher->commit();
+}
+
 // Check if level is complete
 bool Game::checkLevelComplete() const {
     return enemies.empty();
@@ -362,37 +1630,100 @@ bool Game::checkGameOver() const {
 
 // Move to next level
 void Game::nextLevel() {
-    // Reset enemies and bullets
-    initializeEnemies();
+    AllocationTag tag("nextLevel");
+    levelTicks = 0;
+
+    // Reset enemies, bullets and bunkers
+    if (isGeneratedLevel(level)) {
+        // Normally finished long ago; get() only waits if the wave was cleared very quickly
+        applyWave(nextWave.get());
+    }
+    else {
+        // Update game parameters for the new level before building its formation
+        setLevelParameters();
+        initializeEnemies();
+    }
+
+    // The wave after a generated one, or after the last scripted level, is built in the background
+    if (isGeneratedLevel(level + 1)) {
+        prepareNextWave();
+    }
+    applyTuning();
     bullets.clear();
+    bunkers.reset();
+    particles.clear();
+
+    resetScripts();
+    logEvent(EVENT_LEVEL_START, 0, player.getX(), player.getY(), level);
+}
+
+// Endless mode plays the scripted levels first, then generated waves
+bool Game::isGeneratedLevel(int number) const {
+    return endless && number > SCRIPTED_LEVELS;
+}
 
-    // Update game parameters for the new level
-    setLevelParameters();
+// Start building the wave after the current one on a background thread
+void Game::prepareNextWave() {
+    AllocationTag tag("prepareNextWave");
+    // The generator thread allocates freely, but under a tag of its own so it shows up in the report
+    nextWave = std::async(std::launch::async, [](std::uint64_t seed, int nextLevel) {
+        AllocationTag tag("generateWave");
+        return generateWave(seed, nextLevel);
+    }, waveSeed, level + 1);
+}
+
+// Take over a generated wave - only moves, so the first frame of the wave does no construction
+void Game::applyWave(Wave&& wave) {
+    enemies = std::move(wave.enemies);
+    killed.reserve(enemies.size());
+    if (jobSystem) {
+        enemyRowList.reserve(enemies.size() * SPRITE_MAX_HEIGHT);
+    }
+    enemyUpdateInterval = wave.enemyUpdateInterval;
+    enemyShootInterval = wave.enemyShootInterval;
+    enemyRows = wave.enemyRows;
+    enemyCols = wave.enemyCols;
 }
 
 // Set level parameters
 void Game::setLevelParameters() {
-    switch (level) {
-    case 1:
-        enemyUpdateInterval = std::chrono::milliseconds(500);
-        enemyShootInterval = std::chrono::milliseconds(1500);
-        enemyRows = 5;
-        enemyCols = 8;
-        break;
+    if (level < 1 || level > TUNED_LEVELS) {
+        return;
+    }
+    const LevelTuning& parameters = tuning->levels[level - 1];
+    enemyUpdateInterval = std::chrono::milliseconds(parameters.enemyUpdateInterval);
+    enemyShootInterval = std::chrono::milliseconds(parameters.enemyShootInterval);
+    enemyRows = parameters.enemyRows;
+    enemyCols = parameters.enemyCols;
+}
 
-    case 2:
-        enemyUpdateInterval = std::chrono::milliseconds(350);
-        enemyShootInterval = std::chrono::milliseconds(1000);
-        enemyRows = 6;
-        enemyCols = 10;
-        break;
+// Pick up the newest tuning; a single load, so it costs nothing when the file has not changed
+void Game::refreshTuning() {
+    if (tuningWatcher) {
+        const Tuning* newest = tuningWatcher->current();
+        if (newest != tuning) {
+            tuning = newest;
+            applyTuning();
+            tuningWatcher->acknowledge(tuning);
+        }
+    }
+}
 
-    case 3:
-        enemyUpdateInterval = std::chrono::milliseconds(200);
-        enemyShootInterval = std::chrono::milliseconds(750);
-        enemyRows = 7;
-        enemyCols = 12;
-        break;
+// Intervals change at once; a new formation size only shows with the next level's formation.
+// Generated waves bring their own intervals, but their enemies are tuned like any others.
+// The governor's budget follows the tick length, and what it measured against the old one is dropped.
+void Game::applyTuning() {
+    governor.setTickBudget(std::chrono::milliseconds(tuning->tickMilliseconds));
+    governor.restartMeasurement();
+    if (!isGeneratedLevel(level) && level >= 1 && level <= TUNED_LEVELS) {
+        enemyUpdateInterval = std::chrono::milliseconds(tuning->levels[level - 1].enemyUpdateInterval);
+        enemyShootInterval = std::chrono::milliseconds(tuning->levels[level - 1].enemyShootInterval);
+    }
+    for (EnemyEntity& entity : enemies) {
+        const EnemyTuning& values = tuning->enemies[entity.index()];
+        Enemy& enemy = asEnemy(entity);
+        enemy.setPoints(values.points);
+        enemy.setShootProbability(values.shootProbability);
     }
 }
 
@@ -412,3 +1743,114 @@ void Game::reset() {
     score = 0;
     initialize();
 }
+
+// Reset the game with a new seed, so the run that follows is reproducible
+void Game::reset(std::uint64_t seed) {
+    waveSeed = seed;
+    gen.seed(static_cast<std::mt19937::result_type>(seed));
+    reset();
+}
+
+// Reserve a snapshot's storage for the largest formation and bullet count this game can have.
+void Game::prepareSnapshot(GameSnapshot& snapshot) const {
+    snapshot.enemies.reserve(std::max(enemies.capacity(), enemies.size()));
+    snapshot.bullets.reserve(BULLET_CAPACITY);
+    snapshot.enemyScripts.reserve(enemyScripts.capacity());
+    snapshot.freeScriptSlots.reserve(freeScriptSlots.capacity());
+}
+
+// Copy the gameplay state out. Containers are assigned into the snapshot's, keeping its capacity.
+void Game::saveSnapshot(GameSnapshot& snapshot) const {
+    TraceScope scope("saveSnapshot");
+    snapshot.player = player;
+    snapshot.partner = partner;
+    snapshot.enemies = enemies;
+    snapshot.bullets = bullets;
+    snapshot.bunkers = bunkers;
+    snapshot.particles.copyLive(particles);
+
+    snapshot.enemyScripts.resize(enemyScripts.size());
+    for (std::size_t i = 0; i < enemyScripts.size(); ++i) {
+        snapshot.enemyScripts[i] = GameSnapshot::SavedScript{ enemyScriptArgs[i], enemyScripts[i].getTicksRun() };
+    }
+    snapshot.freeScriptSlots = freeScriptSlots;
+    snapshot.waveLevel = waveLevel;
+    snapshot.waveTicks = waveScript.getTicksRun();
+
+    snapshot.score = score;
+    snapshot.level = level;
+    snapshot.running = running;
+    snapshot.won = won;
+    snapshot.extraLifeAwarded = extraLifeAwarded;
+    snapshot.levelTicks = levelTicks;
+    snapshot.enemyUpdateInterval = enemyUpdateInterval;
+    snapshot.enemyShootInterval = enemyShootInterval;
+    snapshot.enemyRows = enemyRows;
+    snapshot.enemyCols = enemyCols;
+    snapshot.simulationTime = simulationTime;
+    snapshot.lastEnemyUpdate = lastEnemyUpdate;
+    snapshot.lastEnemyShoot = lastEnemyShoot;
+    snapshot.gen = gen;
+}
+
+// Put the gameplay state back. Scripts are started again with the arguments they were saved with
+// and fast-forwarded by the ticks they had run; coroutine frames themselves are never copied.
+void Game::restoreSnapshot(const GameSnapshot& snapshot) {
+    TraceScope scope("restoreSnapshot");
+    player = snapshot.player;
+    partner = snapshot.partner;
+    enemies = snapshot.enemies;
+    bullets = snapshot.bullets;
+    bunkers = snapshot.bunkers;
+    particles.copyLive(snapshot.particles);
+
+    // Scripts are started again and run up to where the saved ones were; the old frames go back
+    // to the pool first, so there is room for every saved script
+    for (auto& script : enemyScripts) {
+        script = EnemyScript();
+    }
+    waveScript = WaveScript();
+    enemyScripts.resize(snapshot.enemyScripts.size());
+    enemyScriptArgs.resize(snapshot.enemyScripts.size());
+    for (std::size_t i = 0; i < enemyScripts.size(); ++i) {
+        const GameSnapshot::SavedScript& saved = snapshot.enemyScripts[i];
+        enemyScriptArgs[i] = saved.args;
+        enemyScripts[i] = startEnemyScript(scriptPool, saved.args);
+        enemyScripts[i].fastForward(saved.ticksRun);
+    }
+    freeScriptSlots = snapshot.freeScriptSlots;
+    waveLevel = snapshot.waveLevel;
+    waveScript = standardWave(scriptPool, waveLevel);
+    waveScript.fastForward(snapshot.waveTicks);
+
+    score = snapshot.score;
+    level = snapshot.level;
+    running = snapshot.running;
+    won = snapshot.won;
+    extraLifeAwarded = snapshot.extraLifeAwarded;
+    levelTicks = snapshot.levelTicks;
+    enemyUpdateInterval = snapshot.enemyUpdateInterval;
+    enemyShootInterval = snapshot.enemyShootInterval;
+    enemyRows = snapshot.enemyRows;
+    enemyCols = snapshot.enemyCols;
+    simulationTime = snapshot.simulationTime;
+    lastEnemyUpdate = snapshot.lastEnemyUpdate;
+    lastEnemyShoot = snapshot.lastEnemyShoot;
+    gen = snapshot.gen;
+}
+
+// Set the status bar note; short notes fit the string's own buffer
+void Game::setStatusNote(std::string_view note) {
+    statusNote.assign(note.data(), note.size());
+}
+
+// Read access
+const Player& Game::getPlayer() const { return player; }
+const Player& Game::getPartner() const { return partner; }
+bool Game::hasPartner() const { return twoPlayers; }
+const std::vector<EnemyEntity>& Game::getEnemies() const { return enemies; }
+const std::vector<Bullet>& Game::getBullets() const { return bullets; }
+int Game::getLevel() const { return level; }
+bool Game::isRunning() const { return running; }
+bool Game::hasWon() const { return won; }
+std::size_t Game::getScriptFramesInUse() const { return scriptPool.getInUse(); }
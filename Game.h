@@ -2,43 +2,203 @@
 #define GAME_H
 
 #include <vector>
-#include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <conio.h>
 #include <chrono>
 #include <thread>
 #include <random>
+#include <future>
 
 #include "ConsoleUtils.h"
 #include "Player.h"
 #include "Enemy.h"
 #include "Bullet.h"
+#include "Bunkers.h"
+#include "Entity.h"
+#include "EnemyScripts.h"
+#include "Frame.h"
+#include "FrameGovernor.h"
+#include "FrameArena.h"
+#include "ParticleSystem.h"
+#include "WaveGenerator.h"
+#include "AllocationCounter.h"
+#include "Autopilot.h"
+#include "JobSystem.h"
+#include "Trace.h"
+#include "SpectatorServer.h"
+#include "StatePublisher.h"
+#include "SessionRecorder.h"
+#include "EventJournal.h"
+#include "ScoreTable.h"
+#include "TuningWatcher.h"
+#include "GameEvents.h"
+#include "GameSnapshot.h"
+
+// Options for constructing a game
+struct GameOptions {
+    bool endless = false;           // Keep generating waves after level 3
+    bool headless = false;          // Never touch the console; the game is driven through step()
+    bool autopilot = false;         // The built-in bot presses the keys instead of the player
+    std::uint64_t seed = 0;         // Seed for every random decision, 0 picks one at random
+    std::size_t maxScripts = 4096;  // Coroutine frames reserved for enemy scripts
+    int workerThreads = 0;          // Threads for the parallel tick, 0 runs every tick serially
+    bool assertNoAllocations = false;   // Abort if a steady-state tick allocates (GAME_COUNT_ALLOCATIONS builds)
+    unsigned short spectatorPort = 0;   // Stream rendered frames to TCP spectators on this port, 0 for none
+    bool shareState = false;        // Publish every tick into the shared-memory state ring for external tools
+    std::string recordPath;         // Record the session to this file, empty for none
+    std::string journalDirectory;   // Write an event journal per run into this directory, empty for none
+    std::string scoreFile;          // Append every finished run to this high-score table, empty for none
+    std::string playerName = "player";  // Name runs are recorded under in the high-score table
+    std::string tuningPath;         // Load tuning values from this file and reload it when it changes, empty for none
+    bool virtualTerminal = false;   // Draw with ANSI escape sequences instead of console buffer writes
+    bool richOutput = false;        // 24-bit colour and Unicode glyphs for the console (with virtualTerminal), spectators and recordings
+    bool twoPlayers = false;        // A second ship, sharing lives and score with the first (two-player netplay)
+};
+
+// Inputs an external driver can give the player each tick
+enum Action {
+    ACTION_NONE = 0,
+    ACTION_LEFT,
+    ACTION_RIGHT,
+    ACTION_FIRE,
+    ACTION_COUNT
+};
 
 class Game {
 private:
-    // Game objects
+    // Per-tick scratch memory and the frame each tick is drawn into
+    mutable FrameArena frameArena;
+    mutable Frame frame;
+
+    // Adapts render rate and quality to the console's measured speed
+    mutable FrameGovernor governor;
+
+    // Coroutine frames for enemy and wave scripts; declared first so it outlives the scripts
+    ScriptFramePool scriptPool;
+
+    // Game objects, stored by value and updated through static dispatch
     Player player;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::list<std::unique_ptr<Bullet>> bullets;
+    Player partner;                 // Second ship, only in a two-player game
+    bool twoPlayers;
+    std::vector<EnemyEntity> enemies;
+    std::vector<Bullet> bullets;    // Reserved to BULLET_CAPACITY once; spent bullets' slots are reused in place
+    Bunkers bunkers;
+    ParticleSystem particles;
+
+    // Scripts driving enemies out of formation, indexed by Enemy::getScriptSlot(), and what each
+    // was started with
+    std::vector<EnemyScript> enemyScripts;
+    std::vector<EnemyScriptArgs> enemyScriptArgs;
+    std::vector<int> freeScriptSlots;
+    WaveScript waveScript;
+    int waveLevel;                  // Level the wave script was started for
 
     // Game state
     int score;
     int level;
     bool running;
+    bool won;           // Cleared the last level, which also stopped the game
     bool paused;
     std::map<int, std::string> levelMessages;
 
+    bool extraLifeAwarded;
+    bool headless;
+
+    // Escape-sequence output - the style for the console, spectators and recordings, and whether
+    // the console itself is drawn that way (GameOptions::virtualTerminal, if the console supports it)
+    const AnsiStyle* ansiStyle;
+    bool virtualTerminal;
+
+    // Built-in bot, pressing keys through handleKey() when enabled
+    Autopilot autopilot;
+    bool autopilotEnabled;
+
+    // Allocation assertion mode - ticks after the first few of a level must not allocate
+    bool assertNoAllocations;
+    int levelTicks;
+
+    // Endless mode - waves are generated from a seed, the next one on a background thread
+    bool endless;
+    std::uint64_t waveSeed;
+    std::future<Wave> nextWave;
+
     // Game parameters
     std::chrono::milliseconds enemyUpdateInterval;
     std::chrono::milliseconds enemyShootInterval;
     int enemyRows;
     int enemyCols;
 
-    // Timer variables
-    std::chrono::time_point<std::chrono::steady_clock> lastEnemyUpdate;
-    std::chrono::time_point<std::chrono::steady_clock> lastEnemyShoot;
+    // Timer variables - simulated time advances by a fixed step per tick, so runs are reproducible
+    std::chrono::milliseconds simulationTime;
+    std::chrono::milliseconds lastEnemyUpdate;
+    std::chrono::milliseconds lastEnemyShoot;
+
+    // Parallel tick - large ticks run as a job graph on a work-stealing pool (GameOptions::workerThreads)
+    std::unique_ptr<JobSystem> jobSystem;
+
+    JobGraph tickGraph;
+    int tickParts;                  // Slices each parallel stage is cut into
+
+    // Decided before the graph runs; the jobs only read them
+    bool enemyTick;
+    bool shootTick;
+    int marchDirection;
+
+    // Per-slice results, merged in slice order
+    std::vector<char> sliceAtEdge;
+    std::vector<std::array<Bunkers::Row, BUNKER_HEIGHT>> sliceOccupied;
+
+    // Broad phase tables, rebuilt every parallel tick but keeping their capacity
+    std::vector<std::uint32_t> bulletRowStart;
+    std::vector<std::uint32_t> bulletRowFill;
+    std::vector<std::uint32_t> bulletsByRow;
+    std::vector<std::uint32_t> enemyRowStart;
+    std::vector<std::uint32_t> enemyRowFill;
+    std::vector<std::uint32_t> enemyRowList;
+    std::vector<std::vector<std::uint32_t>> candidates;    // Per row band
+    std::vector<std::uint32_t> candidateBegin;             // Per bullet, into its band's candidates
+    std::vector<std::uint32_t> candidateEnd;
+
+    // Collisions found this tick, applied once detection is done. While detecting, a bunker cell
+    // or an enemy claimed by an earlier bullet no longer stops a later one.
+    GameEventQueue collisionEvents;
+    std::array<Bunkers::Row, BUNKER_HEIGHT> bunkerHits;
+    std::vector<char> killed;   // Per enemy
+    std::vector<char> spent;    // Per bullet
+
+    // Spectators watching the rendered frames over TCP (GameOptions::spectatorPort)
+    std::unique_ptr<SpectatorServer> spectators;
+
+    // Shared-memory ring external tools read each tick's state from (GameOptions::shareState)
+    std::unique_ptr<StatePublisher> statePublisher;
+
+    // Session recording of everything shown on the console (GameOptions::recordPath)
+    std::unique_ptr<SessionRecorder> recorder;
+
+    // Gameplay events of the current run (GameOptions::journalDirectory)
+    std::unique_ptr<EventJournal> journal;
+    std::string journalDirectory;
+
+    // Tuning values in effect for the current tick (GameOptions::tuningPath)
+    std::unique_ptr<TuningWatcher> tuningWatcher;
+    const Tuning* tuning;
+
+    // Persistent high scores (GameOptions::scoreFile)
+    std::unique_ptr<ScoreTable> scores;
+    std::string playerName;
+    int bestScore;                  // The player's best finished run, including this session's
+    int runRank;                    // Rank of the run just finished, 0 if outside the top list
+    bool runRecorded;
+
+    // Extra text for the status bar, set by whatever drives the game (e.g. the netplay session)
+    std::string statusNote;
+
+    // Global operator new calls during the last tick (GAME_COUNT_ALLOCATIONS builds only)
+    std::size_t tickAllocations;
 
     // Random number generator
     std::random_device rd;
@@ -46,44 +206,133 @@ private:
 
 public:
     // Constructors and destructor
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     ~Game();
 
     // Game initialization and main loop
     void initialize();
     void run();
+    bool runTick();
 
     // Game state management
     void pause();
     void resume();
     void reset();
+    void reset(std::uint64_t seed);
+
+    // Headless stepping - apply an action (or the autopilot's key), and the partner's action in a
+    // two-player game, and advance one tick; returns false once the game is over
+    bool step(Action action, Action partnerAction = ACTION_NONE);
+
+    // Rollback - copy the gameplay state out and back. prepareSnapshot reserves a snapshot's
+    // storage for this game, after which saving and restoring never allocate.
+    void prepareSnapshot(GameSnapshot& snapshot) const;
+    void saveSnapshot(GameSnapshot& snapshot) const;
+    void restoreSnapshot(const GameSnapshot& snapshot);
 
     // Input handling
     void processInput();
+    void handleKey(int key);
+    void applyAction(Action action);
+    void applyShipAction(int ship, Action action);
 
     // Game logic
     void update();
     void updateEnemies();
     void updateBullets();
+    void interceptBullets();
     void checkCollisions();
+    int shipHitBy(const Bullet& bullet) const;
+
+    // Collision events - detection queues them, then one pass per concern applies them
+    void beginCollisionEvents();
+    bool claimBunkerCell(int x, int y);
+    void detectInvasion();
+    void applyCollisionEvents();
+    void applyBunkerHits();
+    void applyScoring();
+    void applyLives();
+    void spawnHitEffects();
+    void journalCollisionEvents();
+    void removeHitObjects();
+
+    // Tick stages over a range, shared by the serial and the parallel tick
+    bool formationAtEdge(std::size_t begin, std::size_t end, int direction) const;
+    void marchEnemies(std::size_t begin, std::size_t end, int direction, bool shouldMoveDown,
+        std::array<Bunkers::Row, BUNKER_HEIGHT>& occupied);
+    void erodeBunkers(const std::array<Bunkers::Row, BUNKER_HEIGHT>* occupied, int count);
+    void moveBullets(std::size_t begin, std::size_t end);
+    void removeSpentBullets();
+
+    // Parallel tick
+    void buildTickGraph();
+    void updateParallel();
+    void sortBulletsByRow();
+    void indexEnemyRows();
+    void findCollisionCandidates(int part);
+    void resolveCollisions();
+    int bandOfRow(int row) const;
 
     // Level management
     void nextLevel();
     void setLevelParameters();
+    bool isGeneratedLevel(int number) const;
+    void prepareNextWave();
+    void applyWave(Wave&& wave);
 
     // Enemy management
     void initializeEnemies();
     void handleEnemyShoot();
+    int formationDirection(int fallback) const;
+
+    // Enemy scripting
+    void resetScripts();
+    void updateScripts();
+    void launchScripts(const WaveStep& step);
+    void releaseScript(Enemy& enemy);
 
     // Rendering
     void render() const;
+    const Frame& drawFrame() const;
     void renderStatusBar() const;
     void renderGameOver() const;
     void renderLevelTransition() const;
 
+    // Copy the tick's state and the last rendered frame into the shared state ring
+    void publishState();
+
+    // Capture the console into the session recording
+    void recordScreen();
+
+    // Event journal, if there is one
+    void startJournal();
+    void logEvent(EventKind kind, int subject, int x, int y, int value);
+
+    // Take a reloaded tuning between ticks, and apply it to the level and the enemies
+    void refreshTuning();
+    void applyTuning();
+
+    // High-score table, if there is one
+    void finishRun();
+    void renderHighScores(int row) const;
+
     // Helper methods
     bool checkLevelComplete() const;
     bool checkGameOver() const;
+
+    // Text shown at the end of the status bar
+    void setStatusNote(std::string_view note);
+
+    // Read access for external drivers and tools
+    const Player& getPlayer() const;
+    const Player& getPartner() const;
+    bool hasPartner() const;
+    const std::vector<EnemyEntity>& getEnemies() const;
+    const std::vector<Bullet>& getBullets() const;
+    int getLevel() const;
+    bool isRunning() const;
+    bool hasWon() const;
+    std::size_t getScriptFramesInUse() const;
 };
 
 #endif // GAME_H
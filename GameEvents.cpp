@@ -0,0 +1,35 @@
+#include "GameEvents.h"
+
+// Constructor
+GameEventQueue::GameEventQueue(std::size_t capacity)
+    : counts{} {
+    events.reserve(capacity);
+}
+
+// Append an event and count it
+void GameEventQueue::push(GameEventType type, std::uint32_t bullet, std::uint32_t target, int x, int y, int value) {
+    events.push_back({ type, bullet, target, x, y, value });
+    ++counts[type];
+}
+
+// Empty the queue for the next tick
+void GameEventQueue::clear() {
+    events.clear();
+    counts.fill(0);
+}
+
+// Number of queued events
+std::size_t GameEventQueue::size() const {
+    return events.size();
+}
+
+// Number of queued events of one type
+std::uint32_t GameEventQueue::count(GameEventType type) const {
+    return counts[type];
+}
+
+// Iterators over the queued events
+GameEvent* GameEventQueue::begin() { return events.data(); }
+GameEvent* GameEventQueue::end() { return events.data() + events.size(); }
+const GameEvent* GameEventQueue::begin() const { return events.data(); }
+const GameEvent* GameEventQueue::end() const { return events.data() + events.size(); }
@@ -0,0 +1,67 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What collision detection found during a tick. Detection only reads the scene and queues
+// these; Game::applyCollisionEvents() then changes the scene in one pass per concern.
+enum GameEventType : std::uint8_t {
+    GAME_EVENT_BUNKER_HIT = 0,  // bullet stopped by the bunker cell at x, y
+    GAME_EVENT_ENEMY_KILLED,    // bullet took enemy target at x, y; value: its points
+    GAME_EVENT_PLAYER_HIT,      // bullet hit ship target at x, y; value: lives left, once applied
+    GAME_EVENT_INVASION,        // enemy target reached the player's row
+    GAME_EVENT_EXTRA_LIFE,      // queued by the lives pass; value: lives after the award
+    GAME_EVENT_TYPE_COUNT
+};
+
+// Index of the bullet or target an event is about, when it has none
+const std::uint32_t NO_EVENT_INDEX = 0xFFFFFFFF;
+
+struct GameEvent {
+    GameEventType type;
+    std::uint32_t bullet;       // Index into the tick's bullets
+    std::uint32_t target;       // Index into the tick's enemies, or the ship hit (0 player, 1 partner)
+    int x;
+    int y;
+    int value;
+};
+
+// Events of one tick, in the order they were found.
+// Storage is reserved up front and kept across ticks, so queueing never allocates in steady state.
+class GameEventQueue {
+private:
+    std::vector<GameEvent> events;
+    std::array<std::uint32_t, GAME_EVENT_TYPE_COUNT> counts;
+
+public:
+    // Constructors - reserves room for capacity events
+    explicit GameEventQueue(std::size_t capacity);
+    GameEventQueue(const GameEventQueue& other) = default;
+    GameEventQueue(GameEventQueue&& other) noexcept = default;
+    ~GameEventQueue() = default;
+
+    // Assignment operator
+    GameEventQueue& operator=(const GameEventQueue& other) = default;
+    GameEventQueue& operator=(GameEventQueue&& other) noexcept = default;
+
+    // Queue an event
+    void push(GameEventType type, std::uint32_t bullet, std::uint32_t target, int x, int y, int value);
+
+    // Drop every event, keeping the storage
+    void clear();
+
+    // Events queued so far, and how many of one type, so a pass can skip a tick with none
+    std::size_t size() const;
+    std::uint32_t count(GameEventType type) const;
+
+    // Iteration in queue order; passes may fill in an event's value
+    GameEvent* begin();
+    GameEvent* end();
+    const GameEvent* begin() const;
+    const GameEvent* end() const;
+};
+
+#endif // GAME_EVENTS_H
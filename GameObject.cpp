@@ -1,23 +1,24 @@
 #include "GameObject.h"
 
 // Default constructor
-GameObject::GameObject() : x(0), y(0), symbol(' '), color(WHITE) {}
+GameObject::GameObject() : x(0), y(0), symbol(' '), color(WHITE), sprite(nullptr) {}
 
 // Parameterized constructor
 GameObject::GameObject(int x, int y, char symbol, COLORS color)
-    : x(x), y(y), symbol(symbol), color(color) {}
+    : x(x), y(y), symbol(symbol), color(color), sprite(nullptr) {}
 
 // Copy constructor
 GameObject::GameObject(const GameObject& other)
-    : x(other.x), y(other.y), symbol(other.symbol), color(other.color) {}
+    : x(other.x), y(other.y), symbol(other.symbol), color(other.color), sprite(other.sprite) {}
 
 // Move constructor
 GameObject::GameObject(GameObject&& other) noexcept
-    : x(other.x), y(other.y), symbol(other.symbol), color(other.color) {
+    : x(other.x), y(other.y), symbol(other.symbol), color(other.color), sprite(other.sprite) {
     other.x = 0;
     other.y = 0;
     other.symbol = ' ';
     other.color = WHITE;
+    other.sprite = nullptr;
 }
 
 // Destructor
@@ -30,6 +31,7 @@ GameObject& GameObject::operator=(const GameObject& other) {
         y = other.y;
         symbol = other.symbol;
         color = other.color;
+        sprite = other.sprite;
     }
     return *this;
 }
@@ -41,11 +43,13 @@ GameObject& GameObject::operator=(GameObject&& other) noexcept {
         y = other.y;
         symbol = other.symbol;
         color = other.color;
+        sprite = other.sprite;
 
         other.x = 0;
         other.y = 0;
         other.symbol = ' ';
         other.color = WHITE;
+        other.sprite = nullptr;
     }
     return *this;
 }
@@ -55,21 +59,41 @@ int GameObject::getX() const { return x; }
 int GameObject::getY() const { return y; }
 char GameObject::getSymbol() const { return symbol; }
 COLORS GameObject::getColor() const { return color; }
+const Sprite* GameObject::getSprite() const { return sprite; }
 
 // Setters
 void GameObject::setX(int x) { this->x = x; }
 void GameObject::setY(int y) { this->y = y; }
 void GameObject::setSymbol(char symbol) { this->symbol = symbol; }
 void GameObject::setColor(COLORS color) { this->color = color; }
+void GameObject::setSprite(const Sprite* sprite) { this->sprite = sprite; }
+
+// Extents
+int GameObject::getLeft() const { return sprite ? x - sprite->getOriginX() : x; }
+int GameObject::getRight() const { return sprite ? getLeft() + sprite->getWidth() - 1 : x; }
+int GameObject::getTop() const { return sprite ? y - sprite->getOriginY() : y; }
+int GameObject::getBottom() const { return sprite ? getTop() + sprite->getHeight() - 1 : y; }
 
 // Render the game object
 void GameObject::render() const {
-    drawCharAtPosition(x, y, symbol, color);
+    if (sprite) {
+        drawSpriteAtPosition(getLeft(), getTop(), *sprite);
+    }
+    else {
+        drawCharAtPosition(x, y, symbol, color);
+    }
 }
 
 // Collision detection
+// Two single cells compare positions; anything with a sprite does a mask overlap test
 bool GameObject::collidesWith(const GameObject& other) const {
-    return (x == other.x && y == other.y);
+    if (!sprite && !other.sprite) {
+        return (x == other.x && y == other.y);
+    }
+
+    const Sprite& mine = sprite ? *sprite : SINGLE_CELL_SPRITE;
+    const Sprite& theirs = other.sprite ? *other.sprite : SINGLE_CELL_SPRITE;
+    return mine.overlaps(getLeft(), getTop(), theirs, other.getLeft(), other.getTop());
 }
 
 // Output stream operator
@@ -2,6 +2,7 @@
 #define GAME_OBJECT_H
 
 #include "ConsoleUtils.h"
+#include "Sprite.h"
 #include <iostream>
 
 class GameObject {
@@ -9,6 +10,7 @@ protected:
     int x, y;
     char symbol;
     COLORS color;
+    const Sprite* sprite;   // Multi-cell image, nullptr for a single symbol
 
 public:
     // Constructors - Big Five rule
@@ -27,10 +29,18 @@ public:
     int getY() const;
     char getSymbol() const;
     COLORS getColor() const;
+    const Sprite* getSprite() const;
     void setX(int x);
     void setY(int y);
     void setSymbol(char symbol);
     void setColor(COLORS color);
+    void setSprite(const Sprite* sprite);
+
+    // Extents of the occupied cells, inclusive
+    int getLeft() const;
+    int getRight() const;
+    int getTop() const;
+    int getBottom() const;
 
     // Virtual methods for updating and rendering
     virtual void update() = 0;
@@ -0,0 +1,53 @@
+#include "GameSnapshot.h"
+
+// FNV-1a over a few values at a time
+static void mix(std::uint32_t& hash, std::int64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= static_cast<std::uint8_t>(value >> (i * 8));
+        hash *= 16777619u;
+    }
+}
+
+// Positions, counters and timers, plus the generator's next number standing in for its state.
+// Particles are left out - they are only drawn, never read by the game.
+std::uint32_t GameSnapshot::checksum() const {
+    std::uint32_t hash = 2166136261u;
+    mix(hash, simulationTime.count());
+    mix(hash, level);
+    mix(hash, running);
+    mix(hash, won);
+    mix(hash, player.getScore());
+    mix(hash, player.getLives());
+    mix(hash, player.getX());
+    mix(hash, partner.getX());
+
+    for (const auto& entity : enemies) {
+        const Enemy& enemy = asEnemy(entity);
+        mix(hash, (static_cast<std::int64_t>(enemy.getX()) << 32) | static_cast<std::uint32_t>(enemy.getY()));
+        mix(hash, enemy.getScriptSlot());
+        mix(hash, (static_cast<std::int64_t>(enemy.getPathX()) << 32) | static_cast<std::uint32_t>(enemy.getPathY()));
+        mix(hash, (static_cast<std::int64_t>(enemy.getHeldX()) << 32) | static_cast<std::uint32_t>(enemy.getHeldY()));
+    }
+    for (const auto& script : enemyScripts) {
+        mix(hash, script.args.order);
+        mix(hash, script.ticksRun);
+    }
+    mix(hash, waveTicks);
+    for (const auto& bullet : bullets) {
+        mix(hash, (static_cast<std::int64_t>(bullet.getX()) << 32) | static_cast<std::uint32_t>(bullet.getY()));
+        mix(hash, bullet.getDirection());
+    }
+    for (int y = BUNKER_TOP; y < BUNKER_TOP + BUNKER_HEIGHT; ++y) {
+        for (int x = 0; x < POLE_COLS; x += 64) {
+            std::int64_t bits = 0;
+            for (int bit = 0; bit < 64 && x + bit < POLE_COLS; ++bit) {
+                bits |= static_cast<std::int64_t>(bunkers.contains(x + bit, y)) << bit;
+            }
+            mix(hash, bits);
+        }
+    }
+
+    std::mt19937 next = gen;
+    mix(hash, next());
+    return hash;
+}
@@ -0,0 +1,59 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include "Player.h"
+#include "Entity.h"
+#include "Bullet.h"
+#include "Bunkers.h"
+#include "ParticleSystem.h"
+#include "EnemyScripts.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Everything a tick reads or changes, copied out of a Game so it can be rolled back to this
+// point and resimulated (Game::saveSnapshot / Game::restoreSnapshot). Presentation, the journal
+// and other outputs are not part of it, and neither is an endless game's next wave, which is
+// generated on a background thread. The vectors keep their capacity between saves, so once
+// reserved (Game::prepareSnapshot) saving and restoring never allocate in steady state.
+struct GameSnapshot {
+    Player player;
+    Player partner;
+    std::vector<EnemyEntity> enemies;
+    std::vector<Bullet> bullets;
+    Bunkers bunkers;
+    ParticleSystem particles;
+
+    // Scripts are saved as what they were started with and how many ticks they have run, and
+    // started again on restore; coroutine frames themselves are never copied
+    struct SavedScript {
+        EnemyScriptArgs args;
+        int ticksRun = 0;
+    };
+    std::vector<SavedScript> enemyScripts;     // Indexed by script slot
+    std::vector<int> freeScriptSlots;
+    int waveLevel = 1;
+    int waveTicks = 0;
+
+    int score = 0;
+    int level = 1;
+    bool running = true;
+    bool won = false;
+    bool extraLifeAwarded = false;
+    int levelTicks = 0;
+    std::chrono::milliseconds enemyUpdateInterval{};
+    std::chrono::milliseconds enemyShootInterval{};
+    int enemyRows = 0;
+    int enemyCols = 0;
+    std::chrono::milliseconds simulationTime{};
+    std::chrono::milliseconds lastEnemyUpdate{};
+    std::chrono::milliseconds lastEnemyShoot{};
+    std::mt19937 gen;
+
+    // Hash of the gameplay state, for two copies of a game to check they still agree
+    std::uint32_t checksum() const;
+};
+
+#endif // GAME_SNAPSHOT_H
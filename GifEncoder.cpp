@@ -0,0 +1,166 @@
+#include "GifEncoder.h"
+#include "FrameImage.h"
+#include <algorithm>
+#include <vector>
+
+// 16 colours need four bits; codes start one bit wider to make room for clear and end codes
+static const int MIN_CODE_SIZE = 4;
+static const int CLEAR_CODE = 1 << MIN_CODE_SIZE;
+static const int END_CODE = CLEAR_CODE + 1;
+static const int MAX_CODE = 4095;
+
+// Packs variable-width codes into bytes and the bytes into sub-blocks of up to 255
+class CodeWriter {
+private:
+    std::string& out;
+    std::uint32_t bits;
+    int bitCount;
+    char block[255];
+    int blockSize;
+
+    void flushBlock() {
+        if (blockSize > 0) {
+            out += static_cast<char>(blockSize);
+            out.append(block, blockSize);
+            blockSize = 0;
+        }
+    }
+
+public:
+    explicit CodeWriter(std::string& out) : out(out), bits(0), bitCount(0), block(), blockSize(0) {}
+
+    void write(int code, int size) {
+        bits |= static_cast<std::uint32_t>(code) << bitCount;
+        bitCount += size;
+        while (bitCount >= 8) {
+            block[blockSize++] = static_cast<char>(bits & 0xFF);
+            bits >>= 8;
+            bitCount -= 8;
+            if (blockSize == 255) {
+                flushBlock();
+            }
+        }
+    }
+
+    // Pad the last byte and end the sub-blocks
+    void finish() {
+        if (bitCount > 0) {
+            write(0, 8 - bitCount);
+        }
+        flushBlock();
+        out += '\0';
+    }
+};
+
+// GIF LZW - the dictionary is a trie of code x next pixel, reset whenever it fills up
+static void compressPixels(const std::vector<std::uint8_t>& pixels, std::string& out) {
+    std::vector<std::uint16_t> children((MAX_CODE + 1) * PALETTE_SIZE, 0);
+    int codeSize = MIN_CODE_SIZE + 1;
+    int lastCode = END_CODE;
+
+    out += static_cast<char>(MIN_CODE_SIZE);
+    CodeWriter writer(out);
+    writer.write(CLEAR_CODE, codeSize);
+
+    int current = pixels[0];
+    for (std::size_t i = 1; i < pixels.size(); ++i) {
+        int pixel = pixels[i];
+        std::uint16_t& child = children[current * PALETTE_SIZE + pixel];
+        if (child != 0) {
+            current = child;
+            continue;
+        }
+
+        writer.write(current, codeSize);
+        child = static_cast<std::uint16_t>(++lastCode);
+        if (lastCode >= (1 << codeSize)) {
+            ++codeSize;
+        }
+        if (lastCode == MAX_CODE) {
+            writer.write(CLEAR_CODE, codeSize);
+            std::fill(children.begin(), children.end(), 0);
+            codeSize = MIN_CODE_SIZE + 1;
+            lastCode = END_CODE;
+        }
+        current = pixel;
+    }
+
+    writer.write(current, codeSize);
+    writer.write(END_CODE, codeSize);
+    writer.finish();
+}
+
+static bool sameCell(const Cell& a, const Cell& b) {
+    return a.glyph == b.glyph && (a.glyph == ' ' || (a.color & 0x0F) == (b.color & 0x0F));
+}
+
+GifFrame encodeGifFrame(const Frame* previous, const Frame& current) {
+    GifFrame result = { 0, 0, 0, 0, {} };
+
+    // Bounding rectangle of the changed cells
+    int left = POLE_COLS;
+    int top = POLE_ROWS;
+    int right = -1;
+    int bottom = -1;
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        for (int x = 0; x < POLE_COLS; ++x) {
+            if (previous == nullptr || !sameCell(previous->at(x, y), current.at(x, y))) {
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+    if (right < 0) {
+        return result;
+    }
+
+    std::vector<std::uint8_t> pixels;
+    rasterizeCells(current, left, top, right, bottom, pixels);
+    result.left = left * GLYPH_WIDTH;
+    result.top = top * GLYPH_HEIGHT;
+    result.width = (right - left + 1) * GLYPH_WIDTH;
+    result.height = (bottom - top + 1) * GLYPH_HEIGHT;
+    compressPixels(pixels, result.data);
+    return result;
+}
+
+static void writeWord(std::ostream& out, int value) {
+    out.put(static_cast<char>(value & 0xFF));
+    out.put(static_cast<char>((value >> 8) & 0xFF));
+}
+
+void writeGifHeader(std::ostream& out) {
+    out.write("GIF89a", 6);
+    writeWord(out, IMAGE_WIDTH);
+    writeWord(out, IMAGE_HEIGHT);
+    out.put(static_cast<char>(0xF3));   // Global colour table of 16 entries, 8 bits per primary
+    out.put(0);                         // Background colour
+    out.put(0);                         // Square pixels
+    out.write(reinterpret_cast<const char*>(CONSOLE_PALETTE), sizeof(CONSOLE_PALETTE));
+
+    // NETSCAPE2.0 application extension - loop forever
+    out.write("\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00", 19);
+}
+
+void writeGifFrame(std::ostream& out, const GifFrame& frame, int delayCentiseconds) {
+    // Graphic control extension - keep the previous image under this one
+    out.write("\x21\xF9\x04\x04", 4);
+    writeWord(out, delayCentiseconds);
+    out.put(0);
+    out.put(0);
+
+    // Image descriptor, no local colour table
+    out.put(0x2C);
+    writeWord(out, frame.left);
+    writeWord(out, frame.top);
+    writeWord(out, frame.width);
+    writeWord(out, frame.height);
+    out.put(0);
+    out.write(frame.data.data(), static_cast<std::streamsize>(frame.data.size()));
+}
+
+void writeGifTrailer(std::ostream& out) {
+    out.put(0x3B);
+}
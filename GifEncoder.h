@@ -0,0 +1,35 @@
+#ifndef GIF_ENCODER_H
+#define GIF_ENCODER_H
+
+#include "Frame.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Animated GIF output of frames, using the 16-colour console palette as the global colour table.
+// A frame only stores the rectangle of cells that changed since the frame before it and is
+// drawn over that one, so a mostly static playing field costs next to nothing.
+// Encoding a frame needs nothing but the two frames, so frames can be encoded in parallel and
+// then written in order.
+
+// A frame, LZW-compressed and ready to write
+struct GifFrame {
+    int left;
+    int top;
+    int width;          // 0 when nothing changed
+    int height;
+    std::string data;   // Minimum code size and image data sub-blocks
+};
+
+// Encode the changes from previous (nullptr for the first frame) to current
+GifFrame encodeGifFrame(const Frame* previous, const Frame& current);
+
+// Header, palette and an instruction to loop forever
+void writeGifHeader(std::ostream& out);
+
+// A frame and how long it stays up, in hundredths of a second
+void writeGifFrame(std::ostream& out, const GifFrame& frame, int delayCentiseconds);
+
+void writeGifTrailer(std::ostream& out);
+
+#endif // GIF_ENCODER_H
@@ -0,0 +1,16 @@
+#include "JobGraph.h"
+
+// Add a job
+int JobGraph::add(Function function, void* context, int part) {
+    jobs.push_back(Job{ function, context, part, {}, 0 });
+    return static_cast<int>(jobs.size()) - 1;
+}
+
+// Add an ordering constraint
+void JobGraph::addDependency(int before, int after) {
+    jobs[before].successors.push_back(after);
+    ++jobs[after].dependencyCount;
+}
+
+const JobGraph::Job& JobGraph::getJob(int id) const { return jobs[id]; }
+std::size_t JobGraph::size() const { return jobs.size(); }
@@ -0,0 +1,46 @@
+#ifndef JOB_GRAPH_H
+#define JOB_GRAPH_H
+
+#include <cstddef>
+#include <vector>
+
+// A fixed set of jobs and the order constraints between them.
+// The graph is built once and run every tick; jobs are plain function pointers with a
+// context and a part number, so running it never allocates.
+class JobGraph {
+public:
+    using Function = void (*)(void* context, int part);
+
+    struct Job {
+        Function function;
+        void* context;
+        int part;
+        std::vector<int> successors;    // Jobs that may only start after this one
+        int dependencyCount;            // Jobs this one waits for
+    };
+
+private:
+    std::vector<Job> jobs;
+
+public:
+    // Constructors - plain data, so the defaults are enough
+    JobGraph() = default;
+    JobGraph(const JobGraph& other) = default;
+    JobGraph(JobGraph&& other) noexcept = default;
+    ~JobGraph() = default;
+
+    // Assignment operator
+    JobGraph& operator=(const JobGraph& other) = default;
+    JobGraph& operator=(JobGraph&& other) noexcept = default;
+
+    // Add a job and get its id
+    int add(Function function, void* context, int part = 0);
+
+    // Make after wait for before
+    void addDependency(int before, int after);
+
+    const Job& getJob(int id) const;
+    std::size_t size() const;
+};
+
+#endif // JOB_GRAPH_H
@@ -0,0 +1,167 @@
+#include "JobSystem.h"
+#include "Trace.h"
+
+// Push onto the back of the ring
+void JobSystem::WorkQueue::push(int job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ring[(head + count) % ring.size()] = job;
+    ++count;
+}
+
+// Owner side - newest job first
+bool JobSystem::WorkQueue::popBack(int& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) {
+        return false;
+    }
+    --count;
+    job = ring[(head + count) % ring.size()];
+    return true;
+}
+
+// Thief side - oldest job first
+bool JobSystem::WorkQueue::stealFront(int& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) {
+        return false;
+    }
+    job = ring[head];
+    head = (head + 1) % ring.size();
+    --count;
+    return true;
+}
+
+// Constructor
+JobSystem::JobSystem(int threadCount)
+    : graph(nullptr), pendingSize(0), remaining(0), generation(0), stopping(false) {
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    for (int thread = 0; thread < threadCount; ++thread) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    // The caller of run() is thread 0
+    for (int thread = 1; thread < threadCount; ++thread) {
+        workers.emplace_back(&JobSystem::workerLoop, this, thread);
+    }
+}
+
+// Destructor
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Sleep until there is a graph to run, then help run it
+void JobSystem::workerLoop(int thread) {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        work(thread);
+    }
+}
+
+// Take jobs until the whole graph is done
+void JobSystem::work(int thread) {
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        int job;
+        if (findJob(thread, job)) {
+            execute(thread, job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Own queue first, then steal, starting with the next thread along
+bool JobSystem::findJob(int thread, int& job) {
+    if (queues[thread]->popBack(job)) {
+        return true;
+    }
+    int threadCount = static_cast<int>(queues.size());
+    for (int offset = 1; offset < threadCount; ++offset) {
+        if (queues[(thread + offset) % threadCount]->stealFront(job)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run one job and queue whatever it unlocks on this thread
+void JobSystem::execute(int thread, int job) {
+    const JobGraph::Job& entry = graph->getJob(job);
+    {
+        TraceScope scope("job");
+        AllocationContextScope allocations(allocationContext);
+        entry.function(entry.context, entry.part);
+    }
+
+    for (int successor : entry.successors) {
+        if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            queues[thread]->push(successor);
+        }
+    }
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Run a graph
+void JobSystem::run(const JobGraph& graph) {
+    std::size_t jobCount = graph.size();
+    if (jobCount == 0) {
+        return;
+    }
+
+    // Sized on the first run of a graph, reused after that
+    if (pendingSize < jobCount) {
+        pending = std::make_unique<std::atomic<int>[]>(jobCount);
+        pendingSize = jobCount;
+        for (auto& queue : queues) {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->ring.assign(jobCount, 0);
+            queue->head = 0;
+        }
+    }
+
+    this->graph = &graph;
+    allocationContext = getAllocationContext();
+    for (std::size_t job = 0; job < jobCount; ++job) {
+        pending[job].store(graph.getJob(static_cast<int>(job)).dependencyCount, std::memory_order_relaxed);
+    }
+    remaining.store(static_cast<int>(jobCount), std::memory_order_release);
+
+    // Roots are dealt out round-robin so every thread starts with something
+    int threadCount = static_cast<int>(queues.size());
+    int next = 0;
+    for (std::size_t job = 0; job < jobCount; ++job) {
+        if (graph.getJob(static_cast<int>(job)).dependencyCount == 0) {
+            queues[next]->push(static_cast<int>(job));
+            next = (next + 1) % threadCount;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++generation;
+    }
+    wake.notify_all();
+
+    work(0);
+    this->graph = nullptr;
+}
+
+int JobSystem::getThreadCount() const { return static_cast<int>(queues.size()); }
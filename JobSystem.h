@@ -0,0 +1,74 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include "JobGraph.h"
+#include "AllocationCounter.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool that runs a JobGraph to completion.
+// Every thread, the caller of run() included, has its own queue: it pushes the jobs it
+// unlocks and pops them from the back, so dependent work tends to stay on one core, and
+// when its queue runs dry it steals from the front of the others.
+class JobSystem {
+private:
+    // Per-thread double-ended queue; each job is pushed at most once per run, so a ring the
+    // size of the graph never overflows
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<int> ring;
+        std::size_t head = 0;
+        std::size_t count = 0;
+
+        void push(int job);
+        bool popBack(int& job);
+        bool stealFront(int& job);
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;    // Slot 0 belongs to the caller of run()
+    std::vector<std::thread> workers;
+
+    // The graph being run and how far along it is
+    const JobGraph* graph;
+    std::unique_ptr<std::atomic<int>[]> pending;        // Unfinished dependencies per job
+    std::size_t pendingSize;
+    std::atomic<int> remaining;
+
+    // Allocation phase, call site and check of the caller of run(), applied to every job
+    AllocationContext allocationContext;
+
+    // Workers sleep between runs; every run bumps the generation to wake them
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    unsigned generation;
+    bool stopping;
+
+    void workerLoop(int thread);
+    void work(int thread);
+    bool findJob(int thread, int& job);
+    void execute(int thread, int job);
+
+public:
+    // Constructors - owns its threads, so it cannot be copied or moved
+    explicit JobSystem(int threadCount);
+    JobSystem(const JobSystem& other) = delete;
+    JobSystem(JobSystem&& other) = delete;
+    ~JobSystem();
+
+    // Assignment operator
+    JobSystem& operator=(const JobSystem& other) = delete;
+    JobSystem& operator=(JobSystem&& other) = delete;
+
+    // Run every job of the graph, respecting its dependencies; the calling thread helps
+    // and returns once all jobs are done
+    void run(const JobGraph& graph);
+
+    // Threads taking part in a run, the caller included
+    int getThreadCount() const;
+};
+
+#endif // JOB_SYSTEM_H
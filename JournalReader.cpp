@@ -0,0 +1,85 @@
+#include "JournalReader.h"
+#include <windows.h>
+#include <cstring>
+
+// Constructor - maps the whole file and checks the header
+JournalReader::JournalReader(const std::string& path)
+    : file(INVALID_HANDLE_VALUE), mapping(nullptr), data(nullptr), size(0), offset(sizeof(JournalHeader)) {
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(JournalHeader))) {
+        return;
+    }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return;
+    }
+    const std::uint8_t* view = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (view == nullptr) {
+        return;
+    }
+    if (std::memcmp(view, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) {
+        UnmapViewOfFile(view);
+        return;
+    }
+    data = view;
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+// Destructor
+JournalReader::~JournalReader() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+}
+
+bool JournalReader::isValid() const {
+    return data != nullptr;
+}
+
+std::uint64_t JournalReader::getSeed() const {
+    return reinterpret_cast<const JournalHeader*>(data)->seed;
+}
+
+// Point the block's columns at the file; they are laid out as EventJournal::writeBlock() writes them
+bool JournalReader::next(JournalBlock& block) {
+    if (data == nullptr || offset + sizeof(JournalBlockHeader) > size) {
+        return false;
+    }
+    const JournalBlockHeader* header = reinterpret_cast<const JournalBlockHeader*>(data + offset);
+    std::size_t count = header->count;
+    std::size_t bytes = sizeof(JournalBlockHeader) + journalColumnBytes(count, 4) * 2 + journalColumnBytes(count, 2) * 3 +
+        journalColumnBytes(count, 1) * 2;
+    if (count == 0 || count > JOURNAL_BLOCK_EVENTS || offset + bytes > size) {
+        return false;
+    }
+
+    const std::uint8_t* column = data + offset + sizeof(JournalBlockHeader);
+    block.count = count;
+    block.ticks = reinterpret_cast<const std::uint32_t*>(column);
+    column += journalColumnBytes(count, 4);
+    block.values = reinterpret_cast<const std::int32_t*>(column);
+    column += journalColumnBytes(count, 4);
+    block.xs = reinterpret_cast<const std::int16_t*>(column);
+    column += journalColumnBytes(count, 2);
+    block.ys = reinterpret_cast<const std::int16_t*>(column);
+    column += journalColumnBytes(count, 2);
+    block.levels = reinterpret_cast<const std::uint16_t*>(column);
+    column += journalColumnBytes(count, 2);
+    block.kinds = column;
+    column += journalColumnBytes(count, 1);
+    block.subjects = column;
+
+    offset += bytes;
+    return true;
+}
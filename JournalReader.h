@@ -0,0 +1,48 @@
+#ifndef JOURNAL_READER_H
+#define JOURNAL_READER_H
+
+#include "EventJournal.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Columns of one journal block, pointing into the mapped file
+struct JournalBlock {
+    std::size_t count;
+    const std::uint32_t* ticks;
+    const std::int32_t* values;
+    const std::int16_t* xs;
+    const std::int16_t* ys;
+    const std::uint8_t* kinds;
+    const std::uint16_t* levels;
+    const std::uint8_t* subjects;
+};
+
+// Maps a journal file read-only and walks its blocks without copying them
+class JournalReader {
+private:
+    void* file;
+    void* mapping;
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t offset;     // Next block
+
+public:
+    // Constructors - owns the mapping, so it cannot be copied or moved
+    explicit JournalReader(const std::string& path);
+    JournalReader(const JournalReader& other) = delete;
+    JournalReader(JournalReader&& other) = delete;
+    ~JournalReader();
+
+    // Assignment operator
+    JournalReader& operator=(const JournalReader& other) = delete;
+    JournalReader& operator=(JournalReader&& other) = delete;
+
+    bool isValid() const;
+    std::uint64_t getSeed() const;
+
+    // The next block; false after the last one, or at a block cut short by a crash
+    bool next(JournalBlock& block);
+};
+
+#endif // JOURNAL_READER_H
@@ -0,0 +1,130 @@
+// Winsock has to come before windows.h, which the game headers pull in
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "NetLink.h"
+#include <cstring>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+
+// Packets the impairment stage can hold back at once; more than that are sent straight away
+static const std::size_t PENDING_SLOTS = 256;
+
+// Winsock is reference counted, so every link can start and stop it
+static bool startWinsock() {
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+}
+
+// Constructor
+NetLink::NetLink(unsigned short localPort, unsigned short remotePort, int delayMilliseconds, int lossPercent)
+    : winsockStarted(false), socket(static_cast<std::uintptr_t>(INVALID_SOCKET)), open(false), remotePort(remotePort),
+    delay(delayMilliseconds), lossPercent(lossPercent), lossRandom(localPort),
+    pending(delayMilliseconds > 0 ? PENDING_SLOTS : 0), pendingFirst(0), pendingCount(0),
+    packetsSent(0), packetsDropped(0) {
+    winsockStarted = startWinsock();
+    if (!winsockStarted) {
+        return;
+    }
+
+    SOCKET udp = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (udp == INVALID_SOCKET) {
+        return;
+    }
+    socket = static_cast<std::uintptr_t>(udp);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(localPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(udp, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) {
+        return;
+    }
+
+    u_long enabled = 1;
+    ioctlsocket(udp, FIONBIO, &enabled);
+    open = true;
+}
+
+// Destructor
+NetLink::~NetLink() {
+    if (socket != static_cast<std::uintptr_t>(INVALID_SOCKET)) {
+        closesocket(static_cast<SOCKET>(socket));
+    }
+    if (winsockStarted) {
+        WSACleanup();
+    }
+}
+
+bool NetLink::isOpen() const {
+    return open;
+}
+
+// Hand a packet to the socket; a full socket buffer loses it like the network would
+void NetLink::transmit(const char* data, std::size_t length) {
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(remotePort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(static_cast<SOCKET>(socket), data, static_cast<int>(length), 0,
+        reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    ++packetsSent;
+}
+
+// Drop or delay the packet, then send it (now or from flush)
+void NetLink::send(const void* data, std::size_t length) {
+    if (!open || length > MAX_PACKET) {
+        return;
+    }
+    if (lossPercent > 0 && static_cast<int>(lossRandom() % 100) < lossPercent) {
+        ++packetsDropped;
+        return;
+    }
+    if (pending.empty() || pendingCount == pending.size()) {
+        transmit(static_cast<const char*>(data), length);
+        return;
+    }
+
+    Pending& slot = pending[(pendingFirst + pendingCount) % pending.size()];
+    slot.due = std::chrono::steady_clock::now() + delay;
+    slot.length = length;
+    std::memcpy(slot.bytes.data(), data, length);
+    ++pendingCount;
+}
+
+// Every packet has the same delay, so the ring is in due order
+void NetLink::flush() {
+    auto now = std::chrono::steady_clock::now();
+    while (pendingCount > 0 && pending[pendingFirst].due <= now) {
+        const Pending& slot = pending[pendingFirst];
+        transmit(slot.bytes.data(), slot.length);
+        pendingFirst = (pendingFirst + 1) % pending.size();
+        --pendingCount;
+    }
+}
+
+bool NetLink::hasPending() const {
+    return pendingCount > 0;
+}
+
+// Receive without blocking. A send to a port nobody has bound yet comes back as a reset on
+// the next receive, which only means the other side hasn't started, so it is skipped.
+int NetLink::receive(void* buffer, std::size_t capacity) {
+    if (!open) {
+        return -1;
+    }
+    for (;;) {
+        int length = recvfrom(static_cast<SOCKET>(socket), static_cast<char*>(buffer), static_cast<int>(capacity), 0, nullptr, nullptr);
+        if (length >= 0) {
+            return length;
+        }
+        if (WSAGetLastError() != WSAECONNRESET) {
+            return -1;
+        }
+    }
+}
+
+std::size_t NetLink::getPacketsSent() const { return packetsSent; }
+std::size_t NetLink::getPacketsDropped() const { return packetsDropped; }
@@ -0,0 +1,75 @@
+#ifndef NET_LINK_H
+#define NET_LINK_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Unreliable datagram link to another process on this machine (UDP over loopback), with an
+// impairment stage for testing: outgoing packets can be held back by a fixed delay and dropped
+// with a given probability. Held packets wait in a fixed ring of slots and leave in order from
+// flush(), so sending never allocates or blocks.
+class NetLink {
+public:
+    static const std::size_t MAX_PACKET = 512;
+
+private:
+    struct Pending {
+        std::chrono::steady_clock::time_point due;
+        std::size_t length;
+        std::array<char, MAX_PACKET> bytes;
+    };
+
+    bool winsockStarted;    // Each successful start is matched by one cleanup
+    std::uintptr_t socket;
+    bool open;
+    unsigned short remotePort;
+
+    // Impairment - delay and loss, drawn from a generator of its own
+    std::chrono::milliseconds delay;
+    int lossPercent;
+    std::mt19937 lossRandom;
+    std::vector<Pending> pending;   // Ring of held packets
+    std::size_t pendingFirst;
+    std::size_t pendingCount;
+
+    std::size_t packetsSent;
+    std::size_t packetsDropped;
+
+    void transmit(const char* data, std::size_t length);
+
+public:
+    // Constructors - owns its socket, so it cannot be copied or moved.
+    // Binds localPort on the loopback interface and sends to remotePort there.
+    NetLink(unsigned short localPort, unsigned short remotePort, int delayMilliseconds = 0, int lossPercent = 0);
+    NetLink(const NetLink& other) = delete;
+    NetLink(NetLink&& other) = delete;
+    ~NetLink();
+
+    // Assignment operator
+    NetLink& operator=(const NetLink& other) = delete;
+    NetLink& operator=(NetLink&& other) = delete;
+
+    // Whether the socket could be bound
+    bool isOpen() const;
+
+    // Send a packet of up to MAX_PACKET bytes through the impairment stage
+    void send(const void* data, std::size_t length);
+
+    // Send the held packets whose delay has passed
+    void flush();
+
+    // Whether packets are still held back
+    bool hasPending() const;
+
+    // Read one waiting packet into buffer; returns its length, or -1 when nothing is waiting
+    int receive(void* buffer, std::size_t capacity);
+
+    std::size_t getPacketsSent() const;
+    std::size_t getPacketsDropped() const;
+};
+
+#endif // NET_LINK_H
@@ -0,0 +1,435 @@
+#include "Netplay.h"
+
+#include <algorithm>
+#include <conio.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+
+// Inputs one packet can carry, oldest unacknowledged first
+static const int MAX_INPUTS_PER_PACKET = 64;
+
+// Pacing and timeouts
+static const int MAX_CATCH_UP_TICKS = 5;
+static const std::chrono::milliseconds HELLO_INTERVAL(100);
+static const std::chrono::seconds CONNECT_TIMEOUT(60);
+static const std::chrono::seconds PARTNER_TIMEOUT(5);
+static const std::chrono::seconds LINGER_TIMEOUT(2);
+
+static const char PACKET_MAGIC[4] = { 'G', 'O', '2', 'N' };
+
+enum PacketType : std::uint8_t {
+    PACKET_INPUTS = 0,
+    PACKET_QUIT
+};
+
+// One datagram: the sender's unacknowledged inputs, how many of ours it has, and a checksum
+// of a state it has confirmed. Both ends are the same build on the same machine, so the
+// struct goes over the wire as it is, cut off after the inputs it carries.
+struct NetPacket {
+    char magic[4];
+    std::uint8_t type;
+    std::uint8_t player;        // Sender, 1 or 2
+    std::uint8_t count;         // Inputs carried
+    std::uint8_t reserved;
+    std::uint64_t seed;         // Player 1's game seed, 0 from player 2
+    std::uint32_t firstTick;    // Tick of inputs[0]
+    std::uint32_t received;     // Inputs the sender has from us, contiguous from tick 0
+    std::int32_t syncTick;      // Tick whose starting state checksum is, -1 for none
+    std::uint32_t checksum;
+    std::uint8_t inputs[MAX_INPUTS_PER_PACKET];
+};
+
+static const std::size_t PACKET_HEADER_SIZE = offsetof(NetPacket, inputs);
+
+// The keyboard keys the game understands, as actions
+static Action actionForKey(int key) {
+    switch (key) {
+    case 'a':
+    case 'A':
+    case 75: // Left arrow
+        return ACTION_LEFT;
+    case 'd':
+    case 'D':
+    case 77: // Right arrow
+        return ACTION_RIGHT;
+    case ' ':
+        return ACTION_FIRE;
+    default:
+        return ACTION_NONE;
+    }
+}
+
+// Milliseconds in a duration, as a double
+static double toMilliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Constructor
+// Player 1 binds the given port and sends to the next one, player 2 the other way round
+NetplaySession::NetplaySession(const NetplayOptions& options, const GameOptions& gameOptions)
+    : options(options), gameOptions(gameOptions),
+    link(options.player == 1 ? options.port : static_cast<unsigned short>(options.port + 1),
+        options.player == 1 ? static_cast<unsigned short>(options.port + 1) : options.port,
+        options.delayMilliseconds, options.lossPercent),
+    localInputs{}, remoteInputs{}, usedRemote{}, sentAt{},
+    tick(0), remoteReceived(0), remoteAcked(0), rollbackFrom(0), pendingSyncTick(-1), pendingChecksum(0),
+    seed(0), partnerQuit(false) {
+    remoteTickOf.fill(-1);
+
+    // Both sides have to run exactly the same simulation
+    this->gameOptions.twoPlayers = true;
+    this->gameOptions.autopilot = false;
+    this->gameOptions.endless = false;
+    this->gameOptions.spectatorPort = 0;
+    this->gameOptions.shareState = false;
+    this->gameOptions.recordPath.clear();
+    this->gameOptions.journalDirectory.clear();
+    this->gameOptions.scoreFile.clear();
+    this->gameOptions.tuningPath.clear();
+}
+
+// Destructor
+NetplaySession::~NetplaySession() {}
+
+// Say hello until the partner answers; player 2 also learns the seed from it
+bool NetplaySession::waitForPartner() {
+    if (!link.isOpen()) {
+        report.result = "Could not open the netplay port";
+        return false;
+    }
+
+    if (options.player == 1) {
+        seed = gameOptions.seed;
+        if (seed == 0) {
+            std::random_device device;
+            seed = (static_cast<std::uint64_t>(device()) << 32) | device();
+        }
+    }
+    if (!gameOptions.headless) {
+        clearScreen();
+        std::string waiting = "Waiting for player " + std::to_string(3 - options.player) + "... (ESC to cancel)";
+        drawTextAtPosition(POLE_COLS / 2 - static_cast<int>(waiting.size()) / 2, POLE_ROWS / 2, waiting, WHITE);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto nextHello = start;
+    while (lastHeard == std::chrono::steady_clock::time_point() || seed == 0) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextHello) {
+            sendInputs(false);
+            nextHello += HELLO_INTERVAL;
+        }
+        link.flush();
+        receivePackets();
+
+        if (partnerQuit) {
+            report.result = "Partner quit";
+            return false;
+        }
+        if (!gameOptions.headless && _kbhit() && _getch() == 27) {
+            report.result = "Cancelled";
+            return false;
+        }
+        if (now - start > CONNECT_TIMEOUT) {
+            report.result = "No partner turned up";
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Send every local input the partner hasn't acknowledged, plus our latest confirmed checksum
+void NetplaySession::sendInputs(bool quitting) {
+    NetPacket packet;
+    std::memcpy(packet.magic, PACKET_MAGIC, sizeof(packet.magic));
+    packet.type = quitting ? PACKET_QUIT : PACKET_INPUTS;
+    packet.player = static_cast<std::uint8_t>(options.player);
+    packet.reserved = 0;
+    packet.seed = options.player == 1 ? seed : 0;
+
+    long long first = remoteAcked;
+    int count = static_cast<int>(std::min<long long>(MAX_INPUTS_PER_PACKET, tick - first));
+    packet.firstTick = static_cast<std::uint32_t>(first);
+    packet.count = static_cast<std::uint8_t>(count);
+    for (int i = 0; i < count; ++i) {
+        packet.inputs[i] = localInputs[(first + i) % HISTORY];
+    }
+    packet.received = static_cast<std::uint32_t>(remoteReceived);
+
+    // The state before the newest tick both sides have all inputs for
+    long long sync = std::min(remoteReceived, tick - 1);
+    packet.syncTick = -1;
+    packet.checksum = 0;
+    if (game && sync >= 0 && sync > tick - SNAPSHOTS) {
+        packet.syncTick = static_cast<std::int32_t>(sync);
+        packet.checksum = snapshots[sync % SNAPSHOTS].checksum();
+    }
+
+    link.send(&packet, PACKET_HEADER_SIZE + count);
+}
+
+// Take in everything that has arrived
+void NetplaySession::receivePackets() {
+    NetPacket packet;
+    int length;
+    while ((length = link.receive(&packet, sizeof(packet))) >= 0) {
+        if (length < static_cast<int>(PACKET_HEADER_SIZE) || std::memcmp(packet.magic, PACKET_MAGIC, sizeof(packet.magic)) != 0 ||
+            packet.player != 3 - options.player || length < static_cast<int>(PACKET_HEADER_SIZE + packet.count)) {
+            continue;
+        }
+        lastHeard = std::chrono::steady_clock::now();
+        if (packet.type == PACKET_QUIT) {
+            partnerQuit = true;
+            continue;
+        }
+        if (options.player == 2 && seed == 0) {
+            seed = packet.seed;
+        }
+
+        // The partner's acknowledgement times the round trip of our newest acknowledged input
+        if (packet.received > remoteAcked && packet.received <= tick) {
+            remoteAcked = packet.received;
+            report.pingMs = toMilliseconds(lastHeard - sentAt[(remoteAcked - 1) % HISTORY]);
+        }
+
+        for (int i = 0; i < packet.count; ++i) {
+            rememberRemoteInput(static_cast<long long>(packet.firstTick) + i, packet.inputs[i]);
+        }
+        if (packet.syncTick >= 0) {
+            pendingSyncTick = packet.syncTick;
+            pendingChecksum = packet.checksum;
+        }
+    }
+}
+
+// Store a remote input; one that contradicts what an earlier tick ran with schedules a rollback
+void NetplaySession::rememberRemoteInput(long long remoteTick, std::uint8_t action) {
+    if (remoteTick < remoteReceived || remoteTick >= remoteReceived + HISTORY) {
+        return;
+    }
+    int slot = static_cast<int>(remoteTick % HISTORY);
+    if (remoteTickOf[slot] == remoteTick) {
+        return;
+    }
+
+    remoteTickOf[slot] = remoteTick;
+    remoteInputs[slot] = action;
+    if (remoteTick < tick && usedRemote[slot] != action) {
+        rollbackFrom = std::min(rollbackFrom, remoteTick);
+    }
+    while (remoteTickOf[remoteReceived % HISTORY] == remoteReceived) {
+        ++remoteReceived;
+    }
+}
+
+// Without news from the partner, assume it keeps doing what it last did
+std::uint8_t NetplaySession::predictedRemote() const {
+    return remoteReceived > 0 ? remoteInputs[(remoteReceived - 1) % HISTORY] : static_cast<std::uint8_t>(ACTION_NONE);
+}
+
+// Run tick t from the current state, snapshotting the state first
+void NetplaySession::simulate(long long t) {
+    game->saveSnapshot(snapshots[t % SNAPSHOTS]);
+
+    int slot = static_cast<int>(t % HISTORY);
+    std::uint8_t remote = remoteTickOf[slot] == t ? remoteInputs[slot] : predictedRemote();
+    usedRemote[slot] = remote;
+
+    Action local = static_cast<Action>(localInputs[slot]);
+    if (options.player == 1) {
+        game->step(local, static_cast<Action>(remote));
+    }
+    else {
+        game->step(static_cast<Action>(remote), local);
+    }
+}
+
+// Go back to the first mispredicted tick and run forward again with what is now known
+void NetplaySession::rollBack() {
+    if (rollbackFrom >= tick) {
+        rollbackFrom = tick;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    game->restoreSnapshot(snapshots[rollbackFrom % SNAPSHOTS]);
+    for (long long t = rollbackFrom; t < tick; ++t) {
+        simulate(t);
+    }
+    double elapsed = toMilliseconds(std::chrono::steady_clock::now() - start);
+
+    int depth = static_cast<int>(tick - rollbackFrom);
+    ++report.rollbacks;
+    report.resimulatedTicks += depth;
+    report.deepestRollback = std::max(report.deepestRollback, depth);
+    report.worstRollbackMs = std::max(report.worstRollbackMs, elapsed);
+    rollbackFrom = tick;
+}
+
+// Compare the partner's checksum with ours once we have confirmed the same tick
+bool NetplaySession::checkSync() {
+    if (pendingSyncTick < 0 || pendingSyncTick >= tick || pendingSyncTick > remoteReceived) {
+        return true;
+    }
+    long long syncTick = pendingSyncTick;
+    pendingSyncTick = -1;
+    if (syncTick <= tick - SNAPSHOTS) {
+        return true;
+    }
+    return snapshots[syncTick % SNAPSHOTS].checksum() == pendingChecksum;
+}
+
+// The bot's move or the last key pressed since the previous tick
+std::uint8_t NetplaySession::chooseLocalInput() {
+    if (options.autopilot) {
+        const Player& ship = options.player == 1 ? game->getPlayer() : game->getPartner();
+        return static_cast<std::uint8_t>(actionForKey(autopilot.chooseKey(*game, ship)));
+    }
+
+    Action action = ACTION_NONE;
+    while (!gameOptions.headless && _kbhit()) {
+        int key = _getch();
+        if (key == 27) {
+            report.result = "Quit";
+        }
+        else if (actionForKey(key) != ACTION_NONE) {
+            action = actionForKey(key);
+        }
+    }
+    return static_cast<std::uint8_t>(action);
+}
+
+// Who we are and how the connection is doing, at the end of the status bar
+void NetplaySession::updateStatus() {
+    char note[96];
+    std::snprintf(note, sizeof(note), "P%d | Ping: %d ms | Rollbacks: %lld (deepest %d)",
+        options.player, static_cast<int>(report.pingMs), report.rollbacks, report.deepestRollback);
+    game->setStatusNote(note);
+}
+
+// Connect, then tick on a fixed schedule: take in the partner's inputs, roll back if a
+// prediction was wrong, run the ticks that are due, send our inputs and draw
+NetplayReport NetplaySession::run() {
+    if (!waitForPartner()) {
+        return report;
+    }
+
+    gameOptions.seed = seed;
+    game = std::make_unique<Game>(gameOptions);
+    snapshots.resize(SNAPSHOTS);
+    for (auto& snapshot : snapshots) {
+        game->prepareSnapshot(snapshot);
+    }
+
+    const std::chrono::milliseconds interval(options.tickMilliseconds);
+    auto nextTick = std::chrono::steady_clock::now();
+    auto lastSent = nextTick;
+    lastHeard = nextTick;
+
+    for (;;) {
+        link.flush();
+        receivePackets();
+        bool rolledBack = rollbackFrom < tick;
+        rollBack();
+
+        auto now = std::chrono::steady_clock::now();
+        if (!checkSync()) {
+            report.desynced = true;
+            report.result = "Desync detected";
+            break;
+        }
+        if (partnerQuit) {
+            report.result = "Partner quit";
+            break;
+        }
+        if (!report.result.empty()) {
+            break;
+        }
+        if (now - lastHeard > PARTNER_TIMEOUT) {
+            report.result = "Lost the partner";
+            break;
+        }
+
+        // Over once the last tick is confirmed, so no late input can bring the game back
+        if (!game->isRunning() && remoteReceived >= tick) {
+            report.result = game->hasWon() ? "Won" : "Game over";
+            break;
+        }
+
+        // Run what is due, unless that would predict further ahead than a rollback can reach
+        int ticksRun = 0;
+        while (game->isRunning() && now >= nextTick && ticksRun < MAX_CATCH_UP_TICKS && report.result.empty()) {
+            nextTick += interval;
+            if (tick >= remoteReceived + MAX_ROLLBACK || tick >= remoteAcked + HISTORY) {
+                ++report.stalls;
+                break;
+            }
+
+            int slot = static_cast<int>(tick % HISTORY);
+            localInputs[slot] = chooseLocalInput();
+            sentAt[slot] = now;
+            simulate(tick);
+            ++tick;
+            ++ticksRun;
+        }
+        if (now - nextTick > MAX_CATCH_UP_TICKS * interval) {
+            nextTick = now;
+        }
+
+        if (ticksRun > 0 || now - lastSent >= interval) {
+            sendInputs(false);
+            lastSent = now;
+        }
+        if (!gameOptions.headless && (ticksRun > 0 || rolledBack)) {
+            updateStatus();
+            game->render();
+        }
+        if (ticksRun == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Make sure the partner can confirm the end too, or hears that we left, before the socket closes
+    bool leaving = report.result == "Quit";
+    bool finished = !game->isRunning() && !report.desynced && !partnerQuit;
+    if (leaving) {
+        sendInputs(true);
+    }
+    auto lingerStart = std::chrono::steady_clock::now();
+    while ((leaving || finished) && std::chrono::steady_clock::now() - lingerStart < LINGER_TIMEOUT) {
+        if (finished && remoteAcked < tick) {
+            sendInputs(false);
+        }
+        else if (!link.hasPending()) {
+            break;
+        }
+        link.flush();
+        receivePackets();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    report.ticks = tick;
+    report.score = game->getPlayer().getScore();
+    report.level = game->getLevel();
+    report.packetsSent = link.getPacketsSent();
+    report.packetsDropped = link.getPacketsDropped();
+
+    if (!gameOptions.headless && !game->isRunning()) {
+        game->renderGameOver();
+        _getch();
+    }
+    return report;
+}
+
+void printNetplayReport(const NetplayReport& report, std::ostream& os) {
+    os << "Netplay: " << report.result << std::endl;
+    os << "Ticks: " << report.ticks << ", score " << report.score << ", level " << report.level << std::endl;
+    os << "Rollbacks: " << report.rollbacks << " (" << report.resimulatedTicks << " ticks resimulated, deepest "
+        << report.deepestRollback << ", slowest " << report.worstRollbackMs << " ms)" << std::endl;
+    os << "Stalls: " << report.stalls << ", ping " << report.pingMs << " ms" << std::endl;
+    os << "Packets: " << report.packetsSent << " sent, " << report.packetsDropped << " dropped by the injector" << std::endl;
+}
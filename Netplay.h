@@ -0,0 +1,116 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include "Game.h"
+#include "NetLink.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// How a two-player session is set up
+struct NetplayOptions {
+    int player = 1;                 // 1 hosts and picks the seed, 2 joins
+    unsigned short port = 0;        // Player 1 binds this port on localhost, player 2 the one after it
+    int delayMilliseconds = 0;      // Injected one-way latency on outgoing packets
+    int lossPercent = 0;            // Injected loss of outgoing packets
+    int tickMilliseconds = 50;      // Real time per tick; both sides must agree
+    bool autopilot = false;         // The bot flies the local ship
+};
+
+// Outcome of a session
+struct NetplayReport {
+    std::string result;             // How it ended
+    long long ticks = 0;
+    int score = 0;
+    int level = 0;
+    long long rollbacks = 0;
+    long long resimulatedTicks = 0;
+    int deepestRollback = 0;        // Ticks resimulated by the largest rollback
+    double worstRollbackMs = 0.0;   // Restore plus resimulation, for the slowest rollback
+    long long stalls = 0;           // Ticks held back because the partner's inputs were too far behind
+    double pingMs = 0.0;            // Round trip, from input sent to input acknowledged
+    std::size_t packetsSent = 0;
+    std::size_t packetsDropped = 0;
+    bool desynced = false;
+};
+
+// Two-player co-op over loopback UDP, one process per player, with rollback.
+//
+// Both processes run the same deterministic game: player 1's ship is driven by player 1's inputs,
+// the partner ship by player 2's. Every tick each side sends all inputs its partner hasn't
+// acknowledged yet, so a lost packet is covered by the next one. A tick whose remote input hasn't
+// arrived runs on a prediction (the last input received); when the real one turns out different,
+// the game is restored from the snapshot taken before that tick and resimulated up to the present,
+// all inside one frame. A side that gets more than MAX_ROLLBACK ticks ahead of its partner's
+// inputs waits instead. Checksums of confirmed states are exchanged to catch any desync.
+class NetplaySession {
+private:
+    static const int MAX_ROLLBACK = 8;
+    static const int SNAPSHOTS = MAX_ROLLBACK + 2;
+    static const int HISTORY = 64;  // Input ring size, in ticks
+
+    NetplayOptions options;
+    GameOptions gameOptions;
+    NetLink link;
+    std::unique_ptr<Game> game;
+    Autopilot autopilot;
+
+    // Inputs per tick, by tick % HISTORY. usedRemote is what the simulation ran with, possibly predicted.
+    std::array<std::uint8_t, HISTORY> localInputs;
+    std::array<std::uint8_t, HISTORY> remoteInputs;
+    std::array<std::uint8_t, HISTORY> usedRemote;
+    std::array<std::int64_t, HISTORY> remoteTickOf;    // Tick each remoteInputs slot holds, -1 for none
+    std::array<std::chrono::steady_clock::time_point, HISTORY> sentAt;
+
+    // Game state before each tick, by tick % SNAPSHOTS
+    std::vector<GameSnapshot> snapshots;
+
+    long long tick;             // Ticks simulated; the next tick to run
+    long long remoteReceived;   // Remote inputs received, contiguous from tick 0
+    long long remoteAcked;      // Local inputs the partner has received
+    long long rollbackFrom;     // Earliest tick that ran on a wrong prediction, or tick for none
+    long long pendingSyncTick;  // Partner's checksum still waiting to be compared, -1 for none
+    std::uint32_t pendingChecksum;
+    std::uint64_t seed;
+    bool partnerQuit;
+    std::chrono::steady_clock::time_point lastHeard;
+
+    NetplayReport report;
+
+    bool waitForPartner();
+    void sendInputs(bool quitting);
+    void receivePackets();
+    void rememberRemoteInput(long long remoteTick, std::uint8_t action);
+    void rollBack();
+    void simulate(long long t);
+    std::uint8_t predictedRemote() const;
+    std::uint8_t chooseLocalInput();
+    bool checkSync();
+    void updateStatus();
+
+public:
+    // Constructors - owns its socket and game, so it cannot be copied or moved.
+    // gameOptions gives the presentation (console, headless, colours); gameplay options that
+    // would make the two sides differ are turned off.
+    NetplaySession(const NetplayOptions& options, const GameOptions& gameOptions);
+    NetplaySession(const NetplaySession& other) = delete;
+    NetplaySession(NetplaySession&& other) = delete;
+    ~NetplaySession();
+
+    // Assignment operator
+    NetplaySession& operator=(const NetplaySession& other) = delete;
+    NetplaySession& operator=(NetplaySession&& other) = delete;
+
+    // Connect, play until the game ends on both sides (or a side quits or disconnects), and report
+    NetplayReport run();
+};
+
+// Print a report in a human readable form
+void printNetplayReport(const NetplayReport& report, std::ostream& os);
+
+#endif // NETPLAY_H
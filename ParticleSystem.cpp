@@ -0,0 +1,96 @@
+#include "ParticleSystem.h"
+
+#include <algorithm>
+
+// Downward pull applied to debris each tick
+static const float GRAVITY = 0.04f;
+
+// Age ramp - particles start as bright sparks and fade into grey dust
+static const int FADE_STEPS = 5;
+static const char FADE_GLYPHS[FADE_STEPS] = { '*', '*', '+', '.', '.' };
+static const COLORS FADE_COLORS[FADE_STEPS] = { WHITE, YELLOW, LIGHT_RED, RED, GREY };
+
+// Constructor
+ParticleSystem::ParticleSystem() : count(0), rngState(0x9E3779B9u) {}
+
+// Uniform random number in [-1, 1)
+float ParticleSystem::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return static_cast<float>(rngState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+// Spawn a burst of particles
+void ParticleSystem::explode(int x, int y, int particles, float speed) {
+    for (int i = 0; i < particles && count < CAPACITY; ++i) {
+        posX[count] = static_cast<float>(x);
+        posY[count] = static_cast<float>(y);
+        // Console cells are about twice as tall as they are wide
+        velX[count] = nextRandom() * speed;
+        velY[count] = nextRandom() * speed * 0.5f;
+        age[count] = 0;
+        lifetime[count] = static_cast<std::uint8_t>(8 + (rngState & 7));
+        ++count;
+    }
+}
+
+// Update all particles
+void ParticleSystem::update() {
+    // Integration - straight-line loop over the arrays, which the compiler can vectorize
+    for (int i = 0; i < count; ++i) {
+        posX[i] += velX[i];
+        posY[i] += velY[i];
+        velY[i] += GRAVITY;
+        age[i]++;
+    }
+
+    // Remove dead particles by moving the last live one into their slot
+    int i = 0;
+    while (i < count) {
+        bool expired = age[i] >= lifetime[i];
+        bool outside = posX[i] < 0.0f || posX[i] >= POLE_COLS || posY[i] < 0.0f || posY[i] >= POLE_ROWS;
+        if (expired || outside) {
+            --count;
+            posX[i] = posX[count];
+            posY[i] = posY[count];
+            velX[i] = velX[count];
+            velY[i] = velY[count];
+            age[i] = age[count];
+            lifetime[i] = lifetime[count];
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+// Render all particles
+void ParticleSystem::render() const {
+    for (int i = 0; i < count; ++i) {
+        int step = age[i] * FADE_STEPS / lifetime[i];
+        drawCharAtPosition(static_cast<int>(posX[i]), static_cast<int>(posY[i]), FADE_GLYPHS[step], FADE_COLORS[step]);
+    }
+}
+
+// Remove all particles
+void ParticleSystem::clear() {
+    count = 0;
+}
+
+// Copy the live prefix of every array and the generator; slots past count are never read
+void ParticleSystem::copyLive(const ParticleSystem& other) {
+    if (this == &other) {
+        return;
+    }
+    count = other.count;
+    rngState = other.rngState;
+    std::copy(other.posX.begin(), other.posX.begin() + count, posX.begin());
+    std::copy(other.posY.begin(), other.posY.begin() + count, posY.begin());
+    std::copy(other.velX.begin(), other.velX.begin() + count, velX.begin());
+    std::copy(other.velY.begin(), other.velY.begin() + count, velY.begin());
+    std::copy(other.age.begin(), other.age.begin() + count, age.begin());
+    std::copy(other.lifetime.begin(), other.lifetime.begin() + count, lifetime.begin());
+}
+
+int ParticleSystem::getCount() const { return count; }
@@ -0,0 +1,57 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "ConsoleUtils.h"
+#include <array>
+#include <cstdint>
+
+// Explosion and debris effects.
+// Particles live in a fixed-capacity pool laid out as parallel arrays (structure of arrays),
+// so the per-tick update is one flat loop over floats and nothing is ever allocated.
+class ParticleSystem {
+public:
+    static const int CAPACITY = 4096;
+
+private:
+    std::array<float, CAPACITY> posX;
+    std::array<float, CAPACITY> posY;
+    std::array<float, CAPACITY> velX;
+    std::array<float, CAPACITY> velY;
+    std::array<std::uint8_t, CAPACITY> age;
+    std::array<std::uint8_t, CAPACITY> lifetime;
+    int count;
+
+    // Small xorshift generator, cheap enough to call per particle
+    std::uint32_t rngState;
+    float nextRandom();
+
+public:
+    // Constructors - plain array data, so the defaults are enough
+    ParticleSystem();
+    ParticleSystem(const ParticleSystem& other) = default;
+    ParticleSystem(ParticleSystem&& other) noexcept = default;
+    ~ParticleSystem() = default;
+
+    // Assignment operator
+    ParticleSystem& operator=(const ParticleSystem& other) = default;
+    ParticleSystem& operator=(ParticleSystem&& other) noexcept = default;
+
+    // Spawn a burst of particles at a cell; extra particles are dropped once the pool is full
+    void explode(int x, int y, int particles, float speed);
+
+    // Move and age every particle, then drop the ones that expired or left the field
+    void update();
+
+    // Draw particles with a glyph and colour that fade with age
+    void render() const;
+
+    // Remove all particles
+    void clear();
+
+    // Become a copy of other, copying only its live particles rather than the whole pool
+    void copyLive(const ParticleSystem& other);
+
+    int getCount() const;
+};
+
+#endif // PARTICLE_SYSTEM_H
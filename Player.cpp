@@ -57,20 +57,20 @@ void Player::setScore(int score) { this->score = score; }
 
 // Movement methods
 void Player::moveLeft() {
-    if (x > 0) {
+    if (getLeft() > 0) {
         x--;
     }
 }
 
 void Player::moveRight() {
-    if (x < POLE_COLS - 1) {
+    if (getRight() < POLE_COLS - 1) {
         x++;
     }
 }
 
 // Shooting method
-std::unique_ptr<Bullet> Player::shoot() const {
-    return std::make_unique<Bullet>(x, y - 1, '^', YELLOW, -1);
+Bullet Player::shoot() const {
+    return Bullet(x, getTop() - 1, '^', YELLOW, -1);
 }
 
 // Update method
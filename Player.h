@@ -6,7 +6,7 @@
 #include <vector>
 #include <memory>
 
-class Player : public GameObject {
+class Player final : public GameObject {
 private:
     int lives;
     int score;
@@ -32,7 +32,7 @@ public:
     // Movement and shooting methods
     void moveLeft();
     void moveRight();
-    std::unique_ptr<Bullet> shoot() const;
+    Bullet shoot() const;
 
     // Override update method
     void update() override;
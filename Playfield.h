@@ -0,0 +1,8 @@
+#ifndef PLAYFIELD_H
+#define PLAYFIELD_H
+
+// Size of the playing field in character cells; the console window and every frame match it
+const int POLE_ROWS = 90;
+const int POLE_COLS = 180;
+
+#endif // PLAYFIELD_H
@@ -0,0 +1,28 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <cstdint>
+
+// Session recording file format, shared by SessionRecorder and RecordingReader.
+//
+// A file is a RecordingHeader followed by records. Each record is two little-endian 32-bit
+// words - milliseconds since the start and payload length, with RECORD_KEYFRAME set in the
+// length of keyframes - and then the payload: ANSI output as produced by AnsiEncoder.
+// A keyframe redraws the whole screen, a delta only what changed since the record before it,
+// so playback can start at any keyframe.
+
+const char RECORDING_MAGIC[8] = { 'G', 'O', '2', 'R', 'E', 'C', '0', '1' };
+
+const std::uint32_t RECORD_KEYFRAME = 0x80000000u;
+
+struct RecordingHeader {
+    char magic[8];
+    std::uint16_t cols;
+    std::uint16_t rows;
+    std::uint32_t keyframeIntervalMs;
+    std::int64_t startTime;     // Seconds since the Unix epoch
+};
+
+static_assert(sizeof(RecordingHeader) == 24, "the recording header is written as is");
+
+#endif // RECORDING_H
@@ -0,0 +1,139 @@
+#include "RecordingReader.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Constructor - checks the header
+RecordingReader::RecordingReader(const std::string& path) : file(path, std::ios::binary), header(), valid(false), indexed(false) {
+    valid = file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) == 0;
+}
+
+// Destructor
+RecordingReader::~RecordingReader() {}
+
+bool RecordingReader::isValid() const {
+    return valid;
+}
+
+const RecordingHeader& RecordingReader::getHeader() const {
+    return header;
+}
+
+bool RecordingReader::readRecordHeader(std::uint32_t& timeMs, std::uint32_t& length) {
+    std::uint32_t words[2];
+    if (!file.read(reinterpret_cast<char*>(words), sizeof(words))) {
+        return false;
+    }
+    timeMs = words[0];
+    length = words[1];
+    return true;
+}
+
+bool RecordingReader::next(RecordingEntry& entry) {
+    std::uint32_t length;
+    if (!valid || !readRecordHeader(entry.timeMs, length)) {
+        return false;
+    }
+    entry.keyframe = (length & RECORD_KEYFRAME) != 0;
+    entry.data.resize(length & ~RECORD_KEYFRAME);
+    return static_cast<bool>(file.read(entry.data.data(), static_cast<std::streamsize>(entry.data.size())));
+}
+
+// Keyframes are at least a few seconds apart, so the walk touches a few bytes per record and
+// nothing of the payloads, and the index stays small
+void RecordingReader::buildIndex() {
+    std::streampos resume = file.tellg();
+    file.clear();
+    file.seekg(sizeof(RecordingHeader));
+
+    for (;;) {
+        std::streamoff position = file.tellg();
+        std::uint32_t recordTime;
+        std::uint32_t length;
+        if (!readRecordHeader(recordTime, length)) {
+            break;
+        }
+        if (length & RECORD_KEYFRAME) {
+            keyframes.push_back(Keyframe{ recordTime, position });
+        }
+        file.seekg(length & ~RECORD_KEYFRAME, std::ios::cur);
+    }
+    indexed = true;
+
+    file.clear();
+    file.seekg(resume);
+}
+
+// Binary search of the keyframe index; record times never decrease
+bool RecordingReader::seek(std::uint32_t timeMs) {
+    if (!valid) {
+        return false;
+    }
+    if (!indexed) {
+        buildIndex();
+    }
+
+    auto after = std::upper_bound(keyframes.begin(), keyframes.end(), timeMs, [](std::uint32_t time, const Keyframe& keyframe) {
+        return time < keyframe.timeMs;
+        });
+    file.clear();
+    if (after == keyframes.begin()) {
+        file.seekg(sizeof(RecordingHeader));
+        return false;
+    }
+    file.seekg((after - 1)->offset);
+    return true;
+}
+
+// JSON string contents; control characters, including ESC, become \u escapes
+static void appendJsonEscaped(std::string& out, const std::string& text) {
+    static const char HEX[] = "0123456789abcdef";
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        }
+        else if (byte < 0x20 || byte >= 0x7F) {
+            // Bytes outside ASCII are shown as Latin-1, which keeps the file valid UTF-8
+            out += "\\u00";
+            out += HEX[byte >> 4];
+            out += HEX[byte & 0x0F];
+        }
+        else {
+            out += c;
+        }
+    }
+}
+
+bool exportAsciicast(RecordingReader& reader, std::ostream& out) {
+    if (!reader.isValid()) {
+        return false;
+    }
+
+    const RecordingHeader& header = reader.getHeader();
+    out << "{\"version\": 2, \"width\": " << header.cols << ", \"height\": " << header.rows
+        << ", \"timestamp\": " << header.startTime << ", \"env\": {\"TERM\": \"xterm-256color\"}}\n";
+
+    RecordingEntry entry;
+    std::string line;
+    bool first = true;
+    std::uint32_t offset = 0;
+    char seconds[32];
+    while (reader.next(entry)) {
+        if (first) {
+            offset = entry.timeMs;
+            first = false;
+        }
+
+        std::snprintf(seconds, sizeof(seconds), "%.3f", (entry.timeMs - offset) / 1000.0);
+        line.assign("[");
+        line += seconds;
+        line += ", \"o\", \"";
+        appendJsonEscaped(line, entry.data);
+        line += "\"]\n";
+        out << line;
+    }
+    return static_cast<bool>(out);
+}
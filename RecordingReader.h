@@ -0,0 +1,65 @@
+#ifndef RECORDING_READER_H
+#define RECORDING_READER_H
+
+#include "Recording.h"
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One record of a session recording
+struct RecordingEntry {
+    std::uint32_t timeMs;
+    bool keyframe;
+    std::string data;
+};
+
+// Reads session recordings written by SessionRecorder, in order or from a point in time
+class RecordingReader {
+private:
+    std::ifstream file;
+    RecordingHeader header;
+    bool valid;
+
+    // Time and file offset of every keyframe, in file order; built by the first seek
+    struct Keyframe {
+        std::uint32_t timeMs;
+        std::streamoff offset;
+    };
+    std::vector<Keyframe> keyframes;
+    bool indexed;
+
+    // Read the two words in front of a record
+    bool readRecordHeader(std::uint32_t& timeMs, std::uint32_t& length);
+
+    // Walk the record headers once and note where the keyframes are
+    void buildIndex();
+
+public:
+    // Constructors - reads from its own file, so it cannot be copied
+    explicit RecordingReader(const std::string& path);
+    RecordingReader(const RecordingReader& other) = delete;
+    RecordingReader(RecordingReader&& other) = default;
+    ~RecordingReader();
+
+    // Assignment operator
+    RecordingReader& operator=(const RecordingReader& other) = delete;
+    RecordingReader& operator=(RecordingReader&& other) = default;
+
+    bool isValid() const;
+    const RecordingHeader& getHeader() const;
+
+    // Read the next record; false at the end of the file
+    bool next(RecordingEntry& entry);
+
+    // Position before the last keyframe at or before timeMs. The first seek indexes the
+    // keyframes, reading only record headers; every seek then searches the index.
+    bool seek(std::uint32_t timeMs);
+};
+
+// Write the recording from its current position as an asciicast v2 file, for asciinema and
+// other players. Times are shifted so the output starts at zero.
+bool exportAsciicast(RecordingReader& reader, std::ostream& out);
+
+#endif // RECORDING_READER_H
@@ -0,0 +1,380 @@
+#include "ScoreTable.h"
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <ctime>
+
+static const char SCORE_TABLE_MAGIC[8] = { 'G', 'O', '2', 'S', 'C', 'O', 'R', 'E' };
+static const std::uint32_t SCORE_TABLE_VERSION = 1;
+
+// Best runs kept in order, and players with an index entry; later players are found by scanning
+static const int TOP_SCORES = 100;
+static const int PLAYER_SLOTS = 4096;
+static const int MAX_INDEXED_PLAYERS = PLAYER_SLOTS * 3 / 4;
+
+// Records room is made for when the file is created, doubled whenever it fills up
+static const std::uint32_t INITIAL_CAPACITY = 1024;
+
+struct ScoreTable::PlayerEntry {
+    char name[SCORE_NAME_LENGTH];
+    std::uint32_t runs;
+    std::uint32_t bestRecord;
+    std::uint32_t lastRecord;
+    std::uint32_t used;
+};
+
+struct ScoreTable::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t capacity;
+    std::atomic<std::uint32_t> recordCount;     // Records that are complete
+    std::uint32_t indexedCount;                 // Records the index below covers
+    std::uint32_t topCount;
+    std::uint32_t playerCount;
+    std::uint32_t top[TOP_SCORES];
+    PlayerEntry players[PLAYER_SLOTS];
+};
+
+// FNV-1a, for player names and record checksums
+static std::uint32_t hashBytes(const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static std::uint32_t checksumOf(const ScoreRecord& record) {
+    return hashBytes(&record, offsetof(ScoreRecord, checksum));
+}
+
+// Names are compared as fixed 16-byte fields
+static void copyName(char (&out)[SCORE_NAME_LENGTH], const std::string& name) {
+    std::memset(out, 0, SCORE_NAME_LENGTH);
+    std::memcpy(out, name.data(), std::min<std::size_t>(name.size(), SCORE_NAME_LENGTH));
+}
+
+std::string scorePlayerName(const ScoreRecord& record) {
+    const char* end = static_cast<const char*>(std::memchr(record.player, 0, SCORE_NAME_LENGTH));
+    return std::string(record.player, end ? end : record.player + SCORE_NAME_LENGTH);
+}
+
+// Constructor - opens or creates the file, and a mutex named after its full path
+ScoreTable::ScoreTable(const std::string& path)
+    : file(INVALID_HANDLE_VALUE), mutex(nullptr), mapping(nullptr), header(nullptr), records(nullptr), mappedCapacity(0) {
+    char fullPath[MAX_PATH];
+    DWORD length = GetFullPathNameA(path.c_str(), MAX_PATH, fullPath, nullptr);
+    if (length == 0 || length >= MAX_PATH) {
+        return;
+    }
+    for (char* c = fullPath; *c; ++c) {
+        *c = static_cast<char>(std::tolower(static_cast<unsigned char>(*c)));
+    }
+    std::string mutexName = "Local\\GameObject2.Scores." + std::to_string(hashBytes(fullPath, std::strlen(fullPath)));
+    mutex = CreateMutexA(nullptr, FALSE, mutexName.c_str());
+    if (mutex == nullptr) {
+        return;
+    }
+
+    file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    if (!lock()) {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        unlock();
+        return;
+    }
+    bool created = fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header));
+    if (!created && !prepare()) {
+        // A file whose creation never finished has no magic yet; anything else is left alone
+        static const char noMagic[sizeof(SCORE_TABLE_MAGIC)] = {};
+        created = map(0) && std::memcmp(header->magic, noMagic, sizeof(noMagic)) == 0;
+        unmap();
+    }
+    if (created && map(INITIAL_CAPACITY)) {
+        initializeHeader();
+    }
+    unlock();
+}
+
+// Destructor
+ScoreTable::~ScoreTable() {
+    unmap();
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+    if (mutex != nullptr) {
+        CloseHandle(mutex);
+    }
+}
+
+// Map the header and room for capacity records, growing the file if it is smaller
+bool ScoreTable::map(std::uint32_t capacity) const {
+    unmap();
+    std::uint64_t bytes = sizeof(Header) + static_cast<std::uint64_t>(capacity) * sizeof(ScoreRecord);
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32), static_cast<DWORD>(bytes), nullptr);
+    if (mapping == nullptr) {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(bytes));
+    if (view == nullptr) {
+        unmap();
+        return false;
+    }
+    header = static_cast<Header*>(view);
+    records = reinterpret_cast<ScoreRecord*>(static_cast<char*>(view) + sizeof(Header));
+    mappedCapacity = capacity;
+    return true;
+}
+
+void ScoreTable::unmap() const {
+    if (header != nullptr) {
+        UnmapViewOfFile(header);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+    mapping = nullptr;
+    header = nullptr;
+    records = nullptr;
+    mappedCapacity = 0;
+}
+
+// An abandoned mutex means its owner died holding it; prepare() then finds any damage
+bool ScoreTable::lock() const {
+    DWORD result = WaitForSingleObject(mutex, INFINITE);
+    return result == WAIT_OBJECT_0 || result == WAIT_ABANDONED;
+}
+
+void ScoreTable::unlock() const {
+    ReleaseMutex(mutex);
+}
+
+bool ScoreTable::prepare() const {
+    if (header == nullptr || header->capacity != mappedCapacity) {
+        // Map the header alone first to learn the current capacity
+        if (!map(0) || std::memcmp(header->magic, SCORE_TABLE_MAGIC, sizeof(SCORE_TABLE_MAGIC)) != 0 ||
+            header->version != SCORE_TABLE_VERSION || !map(header->capacity)) {
+            unmap();
+            return false;
+        }
+    }
+    if (header->indexedCount != header->recordCount.load(std::memory_order_acquire)) {
+        rebuildIndex();
+    }
+    return true;
+}
+
+// A new file - the magic goes last, so a half-created file is created again next time
+void ScoreTable::initializeHeader() {
+    std::memset(static_cast<void*>(header), 0, sizeof(Header));
+    header->version = SCORE_TABLE_VERSION;
+    header->capacity = INITIAL_CAPACITY;
+    FlushViewOfFile(header, sizeof(Header));
+    std::memcpy(header->magic, SCORE_TABLE_MAGIC, sizeof(SCORE_TABLE_MAGIC));
+    FlushViewOfFile(header, sizeof(header->magic));
+}
+
+// Start the index over from the records, skipping any that were torn by a crash
+void ScoreTable::rebuildIndex() const {
+    header->indexedCount = 0;
+    header->topCount = 0;
+    header->playerCount = 0;
+    std::memset(header->players, 0, sizeof(header->players));
+
+    std::uint32_t count = header->recordCount.load(std::memory_order_acquire);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (records[i].checksum == checksumOf(records[i])) {
+            indexRecord(i);
+        }
+    }
+    header->indexedCount = count;
+}
+
+// Add a record to the top list and to its player's entry
+void ScoreTable::indexRecord(std::uint32_t index) const {
+    const ScoreRecord& record = records[index];
+
+    // Later runs rank below earlier ones with the same score
+    int position = static_cast<int>(header->topCount);
+    while (position > 0 && records[header->top[position - 1]].score < record.score) {
+        --position;
+    }
+    if (position < TOP_SCORES) {
+        int last = std::min(static_cast<int>(header->topCount), TOP_SCORES - 1);
+        for (int i = last; i > position; --i) {
+            header->top[i] = header->top[i - 1];
+        }
+        header->top[position] = index;
+        header->topCount = std::min<std::uint32_t>(header->topCount + 1, TOP_SCORES);
+    }
+
+    PlayerEntry* entry = findPlayer(record.player, true);
+    if (entry != nullptr) {
+        ++entry->runs;
+        if (entry->bestRecord == NO_SCORE_RECORD || records[entry->bestRecord].score < record.score) {
+            entry->bestRecord = index;
+        }
+        entry->lastRecord = index;
+    }
+}
+
+// Open addressing on the name hash
+ScoreTable::PlayerEntry* ScoreTable::findPlayer(const char* name, bool create) const {
+    std::uint32_t slot = hashBytes(name, SCORE_NAME_LENGTH) % PLAYER_SLOTS;
+    for (int probe = 0; probe < PLAYER_SLOTS; ++probe) {
+        PlayerEntry& entry = header->players[slot];
+        if (!entry.used) {
+            if (!create || header->playerCount >= MAX_INDEXED_PLAYERS) {
+                return nullptr;
+            }
+            std::memcpy(entry.name, name, SCORE_NAME_LENGTH);
+            entry.runs = 0;
+            entry.bestRecord = NO_SCORE_RECORD;
+            entry.lastRecord = NO_SCORE_RECORD;
+            entry.used = 1;
+            ++header->playerCount;
+            return &entry;
+        }
+        if (std::memcmp(entry.name, name, SCORE_NAME_LENGTH) == 0) {
+            return &entry;
+        }
+        slot = (slot + 1) % PLAYER_SLOTS;
+    }
+    return nullptr;
+}
+
+bool ScoreTable::isOpen() const {
+    return header != nullptr;
+}
+
+// Append - the record is written and flushed before the count that makes it part of the table
+int ScoreTable::append(const std::string& player, int score, int level, std::uint64_t seed, std::uint32_t ticks, bool won) {
+    if (!isOpen() || !lock()) {
+        return 0;
+    }
+    if (!prepare()) {
+        unlock();
+        return 0;
+    }
+
+    std::uint32_t index = header->recordCount.load(std::memory_order_relaxed);
+    if (index == header->capacity) {
+        std::uint32_t capacity = header->capacity * 2;
+        if (!map(capacity)) {
+            prepare();
+            unlock();
+            return 0;
+        }
+        header->capacity = capacity;
+        FlushViewOfFile(header, sizeof(Header));
+    }
+
+    ScoreRecord& record = records[index];
+    copyName(record.player, player);
+    record.score = score;
+    record.level = level;
+    record.seed = seed;
+    record.time = static_cast<std::int64_t>(std::time(nullptr));
+    record.ticks = ticks;
+    record.won = won ? 1 : 0;
+    PlayerEntry* entry = findPlayer(record.player, false);
+    record.previousOfPlayer = entry != nullptr ? entry->lastRecord : NO_SCORE_RECORD;
+    record.checksum = checksumOf(record);
+    FlushViewOfFile(&record, sizeof(record));
+
+    header->recordCount.store(index + 1, std::memory_order_release);
+    FlushViewOfFile(header, sizeof(Header));
+
+    indexRecord(index);
+    header->indexedCount = index + 1;
+
+    int rank = 0;
+    for (std::uint32_t i = 0; i < header->topCount; ++i) {
+        if (header->top[i] == index) {
+            rank = static_cast<int>(i) + 1;
+        }
+    }
+    unlock();
+    return rank;
+}
+
+std::vector<ScoreRecord> ScoreTable::top(int count) const {
+    std::vector<ScoreRecord> result;
+    if (!isOpen() || !lock()) {
+        return result;
+    }
+    if (prepare()) {
+        for (std::uint32_t i = 0; i < header->topCount && static_cast<int>(result.size()) < count; ++i) {
+            result.push_back(records[header->top[i]]);
+        }
+    }
+    unlock();
+    return result;
+}
+
+// Follow the player's chain of runs; players without an index entry are found by scanning
+std::vector<ScoreRecord> ScoreTable::history(const std::string& player, int count) const {
+    std::vector<ScoreRecord> result;
+    if (!isOpen() || !lock()) {
+        return result;
+    }
+    if (prepare()) {
+        char name[SCORE_NAME_LENGTH];
+        copyName(name, player);
+        const PlayerEntry* entry = findPlayer(name, false);
+        if (entry != nullptr) {
+            for (std::uint32_t i = entry->lastRecord; i != NO_SCORE_RECORD && static_cast<int>(result.size()) < count; i = records[i].previousOfPlayer) {
+                result.push_back(records[i]);
+            }
+        }
+        else {
+            for (std::uint32_t i = header->recordCount.load(std::memory_order_acquire); i > 0 && static_cast<int>(result.size()) < count; --i) {
+                if (std::memcmp(records[i - 1].player, name, SCORE_NAME_LENGTH) == 0) {
+                    result.push_back(records[i - 1]);
+                }
+            }
+        }
+    }
+    unlock();
+    return result;
+}
+
+bool ScoreTable::best(const std::string& player, ScoreRecord& out) const {
+    if (!isOpen() || !lock()) {
+        return false;
+    }
+    bool found = false;
+    if (prepare()) {
+        char name[SCORE_NAME_LENGTH];
+        copyName(name, player);
+        const PlayerEntry* entry = findPlayer(name, false);
+        if (entry != nullptr && entry->bestRecord != NO_SCORE_RECORD) {
+            out = records[entry->bestRecord];
+            found = true;
+        }
+        else if (entry == nullptr) {
+            for (std::uint32_t i = 0; i < header->recordCount.load(std::memory_order_acquire); ++i) {
+                if (std::memcmp(records[i].player, name, SCORE_NAME_LENGTH) == 0 && (!found || records[i].score > out.score)) {
+                    out = records[i];
+                    found = true;
+                }
+            }
+        }
+    }
+    unlock();
+    return found;
+}
+
+std::uint32_t ScoreTable::size() const {
+    return isOpen() ? header->recordCount.load(std::memory_order_acquire) : 0;
+}
@@ -0,0 +1,87 @@
+#ifndef SCORE_TABLE_H
+#define SCORE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const int SCORE_NAME_LENGTH = 16;
+const std::uint32_t NO_SCORE_RECORD = 0xFFFFFFFFu;
+
+// One finished run, stored as is in the table file
+struct ScoreRecord {
+    char player[SCORE_NAME_LENGTH];     // Not necessarily null-terminated
+    std::int32_t score;
+    std::int32_t level;
+    std::uint64_t seed;
+    std::int64_t time;                  // Seconds since the Unix epoch
+    std::uint32_t ticks;
+    std::uint32_t won;
+    std::uint32_t previousOfPlayer;     // Same player's run before this one, or NO_SCORE_RECORD
+    std::uint32_t checksum;
+};
+
+// Persistent table of finished runs in a memory-mapped file shared by every game on the machine.
+// Records are only ever appended. The file also keeps an index - the best runs overall and a
+// hash table of players with their best and latest run - so the queries the game makes read a
+// few cache lines however many runs there are.
+// A named mutex serialises processes using the same file. A record counts once the record
+// count covers it, which is written after the record itself; a writer that dies while
+// updating the index leaves it marked stale, and the next user rebuilds it from the records.
+class ScoreTable {
+private:
+    struct Header;
+    struct PlayerEntry;
+
+    void* file;
+    void* mutex;
+
+    // Remapped whenever the table has grown, by this process or another one
+    mutable void* mapping;
+    mutable Header* header;
+    mutable ScoreRecord* records;
+    mutable std::uint32_t mappedCapacity;
+
+    bool map(std::uint32_t capacity) const;
+    void unmap() const;
+    bool lock() const;
+    void unlock() const;
+    bool prepare() const;       // Under the lock - follow growth by other processes and repair the index
+    void initializeHeader();
+    void rebuildIndex() const;
+    void indexRecord(std::uint32_t index) const;
+    PlayerEntry* findPlayer(const char* name, bool create) const;
+
+public:
+    // Constructors - owns the mapping, so it cannot be copied or moved
+    explicit ScoreTable(const std::string& path);
+    ScoreTable(const ScoreTable& other) = delete;
+    ScoreTable(ScoreTable&& other) = delete;
+    ~ScoreTable();
+
+    // Assignment operator
+    ScoreTable& operator=(const ScoreTable& other) = delete;
+    ScoreTable& operator=(ScoreTable&& other) = delete;
+
+    bool isOpen() const;
+
+    // Append a finished run; returns its rank among all runs (1 is best), or 0 below the top list
+    int append(const std::string& player, int score, int level, std::uint64_t seed, std::uint32_t ticks, bool won);
+
+    // The best runs, best first
+    std::vector<ScoreRecord> top(int count) const;
+
+    // A player's runs, newest first
+    std::vector<ScoreRecord> history(const std::string& player, int count) const;
+
+    // A player's best run; false if they have none
+    bool best(const std::string& player, ScoreRecord& out) const;
+
+    std::uint32_t size() const;
+};
+
+// Player name of a record as a string
+std::string scorePlayerName(const ScoreRecord& record);
+
+#endif // SCORE_TABLE_H
@@ -0,0 +1,152 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include "ScriptFramePool.h"
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Awaitable that puts the running script to sleep for a number of ticks
+struct WaitTicks {
+    int ticks;
+
+    bool await_ready() const noexcept { return ticks <= 0; }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+        // The tick we suspend on counts as the first one
+        handle.promise().sleepTicks = ticks - 1;
+        handle.promise().step = {};
+    }
+
+    void await_resume() const noexcept {}
+};
+
+inline WaitTicks waitTicks(int ticks) {
+    return WaitTicks{ ticks };
+}
+
+// Coroutine type for scripted behaviour, resumed by the game once per tick.
+// A script co_yields one Step for every tick it acts on and co_awaits waitTicks(n) to idle.
+// The first parameter of every script must be the ScriptFramePool its frame comes from;
+// when the pool is exhausted the script is simply empty instead of falling back to the heap.
+template <typename Step>
+class Script {
+public:
+    struct promise_type {
+        Step step{};
+        int sleepTicks = 0;
+        int ticksRun = 0;
+
+        template <typename... Args>
+        static void* operator new(std::size_t size, ScriptFramePool& pool, Args&&...) noexcept {
+            return pool.allocate(size);
+        }
+
+        static void operator delete(void* frame, std::size_t) noexcept {
+            ScriptFramePool::deallocate(frame);
+        }
+
+        static Script get_return_object_on_allocation_failure() noexcept {
+            return Script();
+        }
+
+        Script get_return_object() noexcept {
+            return Script(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(Step value) noexcept {
+            step = value;
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Script(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+public:
+    // Constructors - a script owns its coroutine frame, so it can only be moved
+    Script() : handle(nullptr) {}
+    Script(const Script& other) = delete;
+    Script(Script&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    ~Script() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Assignment operator
+    Script& operator=(const Script& other) = delete;
+    Script& operator=(Script&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    // Advance the script by one tick and store what it wants to do in step.
+    // Returns false once the script has finished, or if it never got a frame.
+    bool tick(Step& step) {
+        if (!handle || handle.done()) {
+            return false;
+        }
+
+        promise_type& promise = handle.promise();
+        ++promise.ticksRun;
+        if (promise.sleepTicks > 0) {
+            --promise.sleepTicks;
+            step = {};
+            return true;
+        }
+
+        handle.resume();
+        if (handle.done()) {
+            return false;
+        }
+        step = promise.step;
+        return true;
+    }
+
+    bool isRunning() const {
+        return handle && !handle.done();
+    }
+
+    // Ticks the script has been advanced, sleeping ones included
+    int getTicksRun() const {
+        return handle ? handle.promise().ticksRun : 0;
+    }
+
+    // Advance a freshly started script by a number of ticks without looking at its steps,
+    // skipping sleeps in one go. Scripts only depend on their arguments, so a script started
+    // again with the same ones and fast-forwarded by another's getTicksRun() is where that one
+    // was - how a rollback puts scripts back instead of copying coroutine frames.
+    void fastForward(int ticks) {
+        Step ignored;
+        while (ticks > 0 && isRunning()) {
+            promise_type& promise = handle.promise();
+            if (promise.sleepTicks > 0) {
+                int skipped = std::min(promise.sleepTicks, ticks);
+                promise.sleepTicks -= skipped;
+                promise.ticksRun += skipped;
+                ticks -= skipped;
+                continue;
+            }
+            tick(ignored);
+            --ticks;
+        }
+    }
+};
+
+#endif // SCRIPT_H
@@ -0,0 +1,47 @@
+#include "ScriptFramePool.h"
+
+// Constructor
+ScriptFramePool::ScriptFramePool(std::size_t frameSize, std::size_t frameCount)
+    : blockSize((HEADER_SIZE + frameSize + HEADER_SIZE - 1) / HEADER_SIZE * HEADER_SIZE),
+    blockCount(frameCount),
+    storage(new std::byte[blockSize * frameCount]),
+    freeList(nullptr),
+    inUse(0) {
+
+    // Thread every block onto the free list, first block on top
+    for (std::size_t i = frameCount; i > 0; --i) {
+        void* block = storage.get() + (i - 1) * blockSize;
+        *static_cast<void**>(block) = freeList;
+        freeList = block;
+    }
+}
+
+// Destructor
+ScriptFramePool::~ScriptFramePool() {}
+
+// Take a block off the free list
+void* ScriptFramePool::allocate(std::size_t size) noexcept {
+    if (freeList == nullptr || size > blockSize - HEADER_SIZE) {
+        return nullptr;
+    }
+
+    void* block = freeList;
+    freeList = *static_cast<void**>(block);
+    *static_cast<ScriptFramePool**>(block) = this;
+    ++inUse;
+
+    return static_cast<std::byte*>(block) + HEADER_SIZE;
+}
+
+// Put a block back on its pool's free list
+void ScriptFramePool::deallocate(void* frame) noexcept {
+    void* block = static_cast<std::byte*>(frame) - HEADER_SIZE;
+    ScriptFramePool* pool = *static_cast<ScriptFramePool**>(block);
+
+    *static_cast<void**>(block) = pool->freeList;
+    pool->freeList = block;
+    --pool->inUse;
+}
+
+std::size_t ScriptFramePool::getInUse() const { return inUse; }
+std::size_t ScriptFramePool::getCapacity() const { return blockCount; }
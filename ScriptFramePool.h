@@ -0,0 +1,42 @@
+#ifndef SCRIPT_FRAME_POOL_H
+#define SCRIPT_FRAME_POOL_H
+
+#include <cstddef>
+#include <memory>
+
+// Fixed-size block allocator for coroutine frames.
+// All blocks are carved out of one buffer allocated up front; free blocks form an intrusive list,
+// so allocating or freeing a frame is a couple of pointer moves and never touches the heap.
+class ScriptFramePool {
+private:
+    // Every block starts with a pointer back to its pool, padded to keep the frame aligned
+    static const std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    std::size_t blockSize;
+    std::size_t blockCount;
+    std::unique_ptr<std::byte[]> storage;
+    void* freeList;
+    std::size_t inUse;
+
+public:
+    // Constructors - the pool owns its buffer, so it cannot be copied or moved
+    ScriptFramePool(std::size_t frameSize, std::size_t frameCount);
+    ScriptFramePool(const ScriptFramePool& other) = delete;
+    ScriptFramePool(ScriptFramePool&& other) = delete;
+    ~ScriptFramePool();
+
+    // Assignment operator
+    ScriptFramePool& operator=(const ScriptFramePool& other) = delete;
+    ScriptFramePool& operator=(ScriptFramePool&& other) = delete;
+
+    // Get a frame of at least size bytes, or nullptr if the frame is too big or the pool is empty
+    void* allocate(std::size_t size) noexcept;
+
+    // Return a frame to the pool it came from
+    static void deallocate(void* frame) noexcept;
+
+    std::size_t getInUse() const;
+    std::size_t getCapacity() const;
+};
+
+#endif // SCRIPT_FRAME_POOL_H
@@ -0,0 +1,116 @@
+#include "SessionRecorder.h"
+#include "AnsiEncoder.h"
+#include <cstring>
+#include <ctime>
+
+// Constructor - writes the file header and starts mirroring the console
+SessionRecorder::SessionRecorder(const std::string& path, const AnsiStyle& style, std::size_t maxQueuedBytes,
+    std::chrono::milliseconds keyframeInterval)
+    : file(path, std::ios::binary | std::ios::trunc), maxQueuedBytes(maxQueuedBytes), keyframeInterval(keyframeInterval), style(&style),
+    start(std::chrono::steady_clock::now()), needsKeyframe(true), lastKeyframe(start), dropped(0), queuedBytes(0), stopping(false) {
+    if (!file) {
+        return;
+    }
+
+    RecordingHeader header = {};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.cols = static_cast<std::uint16_t>(POLE_COLS);
+    header.rows = static_cast<std::uint16_t>(POLE_ROWS);
+    header.keyframeIntervalMs = static_cast<std::uint32_t>(keyframeInterval.count());
+    header.startTime = static_cast<std::int64_t>(std::time(nullptr));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    setConsoleMirror(&screen);
+    writer = std::thread(&SessionRecorder::writeLoop, this);
+}
+
+// Destructor - stops mirroring and lets the writer drain the queue
+SessionRecorder::~SessionRecorder() {
+    if (getConsoleMirror() == &screen) {
+        setConsoleMirror(nullptr);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+bool SessionRecorder::isOpen() const {
+    return writer.joinable();
+}
+
+// Encode what changed and hand it to the writer; a keyframe after a drop and every interval
+void SessionRecorder::capture() {
+    if (!isOpen()) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    Record record{ static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count()), false, {} };
+    encodeDelta(recorded, screen, record.data, terminal, *style);
+    if (record.data.empty() && !needsKeyframe) {
+        return;
+    }
+    if (needsKeyframe || now - lastKeyframe >= keyframeInterval) {
+        record.keyframe = true;
+        record.data.clear();
+        encodeKeyframe(screen, record.data, terminal, *style);
+    }
+
+    bool keyframe = record.keyframe;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queuedBytes + record.data.size() > maxQueuedBytes) {
+            // The writer is behind - lose this record, and repair the gap with a keyframe
+            ++dropped;
+            needsKeyframe = true;
+            return;
+        }
+        queuedBytes += record.data.size();
+        queue.push_back(std::move(record));
+    }
+    wake.notify_one();
+
+    recorded = screen;
+    if (keyframe) {
+        lastKeyframe = now;
+        needsKeyframe = false;
+    }
+}
+
+std::size_t SessionRecorder::getDropped() const {
+    return dropped;
+}
+
+// Writer thread - takes everything queued at once and writes it outside the lock
+void SessionRecorder::writeLoop() {
+    std::deque<Record> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            batch.swap(queue);
+        }
+
+        std::size_t written = 0;
+        for (const auto& record : batch) {
+            std::uint32_t words[2] = { record.timeMs, static_cast<std::uint32_t>(record.data.size()) | (record.keyframe ? RECORD_KEYFRAME : 0) };
+            file.write(reinterpret_cast<const char*>(words), sizeof(words));
+            file.write(record.data.data(), static_cast<std::streamsize>(record.data.size()));
+            written += record.data.size();
+        }
+        file.flush();
+        batch.clear();
+
+        // Only now is the space free again, so a stalled disk fills the queue
+        std::lock_guard<std::mutex> lock(mutex);
+        queuedBytes -= written;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+#include "AnsiEncoder.h"
+#include "Frame.h"
+#include "Recording.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Records everything written to the console into a session file (see Recording.h).
+// The recorder mirrors the console (setConsoleMirror), and each capture() encodes what changed
+// since the last one. Encoded records go through a bounded queue to a writer thread, so a slow
+// disk never holds up the game: when the queue is full the record is dropped and the next
+// capture writes a keyframe instead.
+class SessionRecorder {
+private:
+    struct Record {
+        std::uint32_t timeMs;
+        bool keyframe;
+        std::string data;
+    };
+
+    std::ofstream file;
+    std::size_t maxQueuedBytes;
+    std::chrono::milliseconds keyframeInterval;
+    const AnsiStyle* style;
+    std::chrono::steady_clock::time_point start;
+
+    // Game thread side
+    Frame screen;       // What the console shows, kept up to date by the console mirror
+    Frame recorded;     // What the last queued record left on screen
+    TerminalState terminal;     // And where it left the cursor and colour
+    bool needsKeyframe;
+    std::chrono::steady_clock::time_point lastKeyframe;
+    std::size_t dropped;
+
+    // Shared with the writer thread
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Record> queue;
+    std::size_t queuedBytes;
+    bool stopping;
+
+    std::thread writer;
+
+    void writeLoop();
+
+public:
+    // Constructors - the recorder owns a thread and a file, so it cannot be copied or moved
+    SessionRecorder(const std::string& path, const AnsiStyle& style = plainAnsiStyle(), std::size_t maxQueuedBytes = 4 * 1024 * 1024,
+        std::chrono::milliseconds keyframeInterval = std::chrono::seconds(5));
+    SessionRecorder(const SessionRecorder& other) = delete;
+    SessionRecorder(SessionRecorder&& other) = delete;
+    ~SessionRecorder();
+
+    // Assignment operator
+    SessionRecorder& operator=(const SessionRecorder& other) = delete;
+    SessionRecorder& operator=(SessionRecorder&& other) = delete;
+
+    bool isOpen() const;
+
+    // Record the console as it is now; does nothing if it has not changed
+    void capture();
+
+    // Records lost to a full queue
+    std::size_t getDropped() const;
+};
+
+#endif // SESSION_RECORDER_H
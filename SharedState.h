@@ -0,0 +1,72 @@
+#ifndef SHARED_STATE_H
+#define SHARED_STATE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Layout of the shared-memory ring the game publishes its state into, one slot per tick.
+// Shared by the writer (StatePublisher) and readers (StateReader), which may be built
+// separately, so everything here has a fixed size and no pointers.
+
+// Name of the file mapping; "Local\" keeps it to the current login session
+const char* const SHARED_STATE_NAME = "Local\\GameObject2.State";
+
+const std::uint32_t SHARED_STATE_MAGIC = 0x53324F47;   // "GO2S"
+const std::uint32_t SHARED_STATE_VERSION = 1;
+
+const int SHARED_STATE_SLOTS = 8;
+const int SHARED_STATE_ROWS = 90;
+const int SHARED_STATE_COLS = 180;
+const int SHARED_MAX_ENEMIES = 1024;
+const int SHARED_MAX_BULLETS = 1024;
+
+// An enemy or bullet; kind is the enemy type index, or 0 for player and 1 for enemy bullets
+struct SharedObject {
+    std::int16_t x;
+    std::int16_t y;
+    std::uint8_t kind;
+    std::int8_t direction;
+    char symbol;
+    std::uint8_t color;
+};
+
+// Everything published for one tick
+struct SharedState {
+    std::uint64_t tick;
+    std::int32_t level;
+    std::int32_t score;
+    std::int32_t lives;
+    std::int16_t playerX;
+    std::int16_t playerY;
+
+    // Objects beyond the maximum are left out; the totals say how many there were
+    std::uint32_t enemyTotal;
+    std::uint32_t bulletTotal;
+    std::uint32_t enemyCount;
+    std::uint32_t bulletCount;
+    SharedObject enemies[SHARED_MAX_ENEMIES];
+    SharedObject bullets[SHARED_MAX_BULLETS];
+
+    // The last rendered frame, row by row
+    char glyphs[SHARED_STATE_ROWS * SHARED_STATE_COLS];
+    std::uint8_t colors[SHARED_STATE_ROWS * SHARED_STATE_COLS];
+};
+
+// Seqlock slot - sequence is odd while the writer is inside the slot and moves on by two per write
+struct SharedStateSlot {
+    std::atomic<std::uint64_t> sequence;
+    SharedState state;
+};
+
+struct SharedStateRing {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t stateSize;
+    std::atomic<std::uint64_t> published;   // Ticks published so far; tick n lives in slot n % slotCount
+    SharedStateSlot slots[SHARED_STATE_SLOTS];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the ring needs lock-free 64-bit atomics to work across processes");
+
+#endif // SHARED_STATE_H
@@ -0,0 +1,147 @@
+#include "Soak.h"
+
+#include <algorithm>
+#include <chrono>
+#include <psapi.h>
+
+// A game still going after this many ticks counts as a timeout
+static const long long MAX_TICKS_PER_GAME = 100000;
+
+// More live bullets than this means they are no longer being removed
+static const std::size_t MAX_LIVE_BULLETS = 1024;
+
+// Starting lives plus the one extra life
+static const int MAX_LIVES = 4;
+
+// Violations kept in the report; the rest are only counted
+static const std::size_t MAX_REPORTED_VIOLATIONS = 20;
+
+// Peak working set of this process so far
+static std::size_t peakWorkingSet() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+}
+
+static bool inBounds(const GameObject& object) {
+    return object.getX() >= 0 && object.getX() < POLE_COLS && object.getY() >= 0 && object.getY() < POLE_ROWS;
+}
+
+// Check everything that must hold after any tick; returns an empty string when all is well
+static std::string checkInvariants(const Game& game, int lastScore, int lastLives) {
+    const Player& player = game.getPlayer();
+
+    if (player.getLives() < 0 || player.getLives() > MAX_LIVES) {
+        return "lives out of range: " + std::to_string(player.getLives());
+    }
+    if (player.getLives() > lastLives + 1) {
+        return "gained more than one life in a tick";
+    }
+    if (player.getScore() < lastScore) {
+        return "score went down from " + std::to_string(lastScore) + " to " + std::to_string(player.getScore());
+    }
+    if (player.getLeft() < 0 || player.getRight() >= POLE_COLS) {
+        return "player off screen at x=" + std::to_string(player.getX());
+    }
+
+    std::size_t scripted = 0;
+    for (const auto& entity : game.getEnemies()) {
+        const Enemy& enemy = asEnemy(entity);
+        if (!inBounds(enemy)) {
+            return "enemy out of bounds at " + std::to_string(enemy.getX()) + "," + std::to_string(enemy.getY());
+        }
+        if (enemy.getScriptSlot() >= 0) {
+            ++scripted;
+        }
+    }
+
+    if (game.getBullets().size() > MAX_LIVE_BULLETS) {
+        return "bullets leaking: " + std::to_string(game.getBullets().size()) + " alive";
+    }
+    for (const auto& bullet : game.getBullets()) {
+        if (!inBounds(bullet)) {
+            return "bullet out of bounds at " + std::to_string(bullet.getX()) + "," + std::to_string(bullet.getY());
+        }
+    }
+
+    // One frame for the wave script, one for each enemy out of formation
+    if (game.getScriptFramesInUse() > scripted + 1) {
+        return "script frames leaking: " + std::to_string(game.getScriptFramesInUse()) + " in use for " +
+            std::to_string(scripted) + " scripted enemies";
+    }
+    return std::string();
+}
+
+// Run the soak
+SoakReport runSoak(int games, const GameOptions& options) {
+    SoakReport report;
+
+    GameOptions soakOptions = options;
+    soakOptions.headless = true;
+    soakOptions.autopilot = true;
+    Game game(soakOptions);
+    std::uint64_t seed = options.seed;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < games; ++i) {
+        std::uint64_t gameSeed = seed + static_cast<std::uint64_t>(i) + 1;
+        game.reset(gameSeed);
+
+        int lastScore = game.getPlayer().getScore();
+        int lastLives = game.getPlayer().getLives();
+        long long tick = 0;
+        bool alive = true;
+        bool failed = false;
+
+        while (alive && tick < MAX_TICKS_PER_GAME) {
+            alive = game.step(ACTION_NONE);
+            ++tick;
+
+            std::string problem = checkInvariants(game, lastScore, lastLives);
+            if (!problem.empty()) {
+                // A broken state usually persists, so only the first violation of a game is listed
+                ++report.violationCount;
+                if (!failed && report.violations.size() < MAX_REPORTED_VIOLATIONS) {
+                    report.violations.push_back("seed " + std::to_string(gameSeed) + ", tick " + std::to_string(tick) + ": " + problem);
+                }
+                failed = true;
+            }
+
+            lastScore = game.getPlayer().getScore();
+            lastLives = game.getPlayer().getLives();
+            report.peakBullets = std::max(report.peakBullets, game.getBullets().size());
+        }
+
+        ++report.games;
+        report.ticks += tick;
+        if (alive) {
+            ++report.timeouts;
+        }
+        else if (game.getPlayer().getLives() > 0) {
+            ++report.wins;
+        }
+        report.totalScore += lastScore;
+        report.bestScore = std::max(report.bestScore, lastScore);
+        report.highestLevel = std::max(report.highestLevel, game.getLevel());
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.peakMemory = peakWorkingSet();
+
+    return report;
+}
+
+// Print the report
+void printSoakReport(const SoakReport& report, std::ostream& os) {
+    os << "Games: " << report.games << " (won " << report.wins << ", timed out " << report.timeouts << ")" << std::endl;
+    os << "Ticks: " << report.ticks << " in " << report.seconds << " s, "
+        << (report.seconds > 0.0 ? report.ticks / report.seconds : 0.0) << " ticks/s" << std::endl;
+    os << "Score: best " << report.bestScore << ", average "
+        << (report.games > 0 ? report.totalScore / report.games : 0) << ", highest level " << report.highestLevel << std::endl;
+    os << "Peak bullets: " << report.peakBullets << ", peak working set: " << report.peakMemory / 1024 << " KB" << std::endl;
+    os << "Invariant violations: " << report.violationCount << std::endl;
+    for (const auto& violation : report.violations) {
+        os << "  " << violation << std::endl;
+    }
+}
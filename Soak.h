@@ -0,0 +1,35 @@
+#ifndef SOAK_H
+#define SOAK_H
+
+#include "Game.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Outcome of a soak run
+struct SoakReport {
+    int games = 0;
+    int wins = 0;
+    int timeouts = 0;                   // Games cut off at the tick limit
+    long long ticks = 0;
+    double seconds = 0.0;
+    long long totalScore = 0;
+    int bestScore = 0;
+    int highestLevel = 0;
+    std::size_t peakBullets = 0;
+    std::size_t peakMemory = 0;         // Peak working set of the process, in bytes
+    long long violationCount = 0;
+    std::vector<std::string> violations;    // The first few, with game seed and tick
+};
+
+// Play games back to back with the autopilot, headless and unthrottled, checking
+// invariants after every tick. Game i is seeded from options.seed and i, so any
+// failure can be replayed on its own. The other options are passed on to the game.
+SoakReport runSoak(int games, const GameOptions& options);
+
+// Print a report in a human readable form
+void printSoakReport(const SoakReport& report, std::ostream& os);
+
+#endif // SOAK_H
@@ -0,0 +1,246 @@
+// Winsock has to come before windows.h, which the game headers pull in
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "SpectatorServer.h"
+#include "AnsiEncoder.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+
+// Buffers handed to one WSASend call
+static const int MAX_GATHER = 64;
+
+// Kernel send buffer per spectator - kept small so a lagging spectator shows up in our own
+// queue, where it can be resynchronised, instead of seconds of stale frames inside the socket
+static const int SEND_BUFFER_BYTES = 64 * 1024;
+
+// Winsock is reference counted, so every server can start and stop it
+static bool startWinsock() {
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+}
+
+static void makeNonBlocking(SOCKET socket) {
+    u_long enabled = 1;
+    ioctlsocket(socket, FIONBIO, &enabled);
+}
+
+// Constructor
+SpectatorServer::SpectatorServer(unsigned short port, const AnsiStyle& style, bool anyInterface, std::size_t maxQueuedBytes)
+    : winsockStarted(false), listenSocket(static_cast<std::uintptr_t>(INVALID_SOCKET)), listening(false), maxQueuedBytes(maxQueuedBytes), style(&style),
+    havePrevious(false), framesPublished(0), keyframesSent(0), resyncs(0), bytesEncoded(0) {
+    winsockStarted = startWinsock();
+    if (!winsockStarted) {
+        return;
+    }
+
+    SOCKET server = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (server == INVALID_SOCKET) {
+        return;
+    }
+    listenSocket = static_cast<std::uintptr_t>(server);
+
+    BOOL reuse = TRUE;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(anyInterface ? INADDR_ANY : INADDR_LOOPBACK);
+    if (bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+        listen(server, SOMAXCONN) == SOCKET_ERROR) {
+        return;
+    }
+
+    makeNonBlocking(server);
+    listening = true;
+}
+
+// Destructor
+SpectatorServer::~SpectatorServer() {
+    for (auto& spectator : spectators) {
+        closesocket(static_cast<SOCKET>(spectator.socket));
+    }
+    if (listenSocket != static_cast<std::uintptr_t>(INVALID_SOCKET)) {
+        closesocket(static_cast<SOCKET>(listenSocket));
+    }
+    if (winsockStarted) {
+        WSACleanup();
+    }
+}
+
+// Accept everyone waiting; new spectators start with a keyframe
+void SpectatorServer::acceptSpectators() {
+    for (;;) {
+        SOCKET client = accept(static_cast<SOCKET>(listenSocket), nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            return;
+        }
+
+        makeNonBlocking(client);
+        BOOL noDelay = TRUE;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        int sendBuffer = SEND_BUFFER_BYTES;
+        setsockopt(client, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&sendBuffer), sizeof(sendBuffer));
+
+        spectators.push_back(Spectator{ static_cast<std::uintptr_t>(client), {}, 0, 0, true });
+    }
+}
+
+// Queue a message; the spectator shares the encoded buffer with everyone else
+void SpectatorServer::enqueue(Spectator& spectator, const Message& message) {
+    spectator.queue.push_back(message);
+    spectator.queuedBytes += message->size();
+}
+
+// Send as much of the queue as the socket takes in one gathered write; false if the connection is gone
+bool SpectatorServer::flush(Spectator& spectator) {
+    while (!spectator.queue.empty()) {
+        WSABUF buffers[MAX_GATHER];
+        DWORD count = 0;
+        for (const auto& message : spectator.queue) {
+            if (count == MAX_GATHER) {
+                break;
+            }
+            std::size_t skip = count == 0 ? spectator.sentOfFront : 0;
+            buffers[count].buf = const_cast<char*>(message->data() + skip);
+            buffers[count].len = static_cast<ULONG>(message->size() - skip);
+            ++count;
+        }
+
+        DWORD sent = 0;
+        if (WSASend(static_cast<SOCKET>(spectator.socket), buffers, count, &sent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+            return WSAGetLastError() == WSAEWOULDBLOCK;
+        }
+
+        // Retire fully sent messages and remember how far into the next one we got
+        spectator.queuedBytes -= sent;
+        std::size_t remaining = sent;
+        while (remaining > 0) {
+            std::size_t left = spectator.queue.front()->size() - spectator.sentOfFront;
+            if (remaining < left) {
+                spectator.sentOfFront += remaining;
+                break;
+            }
+            remaining -= left;
+            spectator.queue.pop_front();
+            spectator.sentOfFront = 0;
+        }
+
+        if (sent == 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+// Spectators only listen, so anything they send is discarded; a zero read means they left
+bool SpectatorServer::isConnected(Spectator& spectator) {
+    char discard[256];
+    for (;;) {
+        int received = recv(static_cast<SOCKET>(spectator.socket), discard, sizeof(discard), 0);
+        if (received > 0) {
+            continue;
+        }
+        if (received == 0) {
+            return false;
+        }
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+    }
+}
+
+void SpectatorServer::closeSpectator(Spectator& spectator) {
+    closesocket(static_cast<SOCKET>(spectator.socket));
+    spectator.socket = static_cast<std::uintptr_t>(INVALID_SOCKET);
+}
+
+// Publish a frame
+void SpectatorServer::publish(const Frame& frame) {
+    if (!listening) {
+        return;
+    }
+    acceptSpectators();
+    ++framesPublished;
+
+    // Encoded at most once each, however many spectators there are. A keyframe ends by moving
+    // to where this frame's delta leaves everyone else, so the next delta suits every spectator
+    Message delta;
+    Message keyframe;
+    auto encodeDeltaOnce = [&] {
+        if (!delta) {
+            auto encoded = std::make_shared<std::string>();
+            encodeDelta(previous, frame, *encoded, terminal, *style);
+            bytesEncoded += encoded->size();
+            delta = std::move(encoded);
+        }
+    };
+    auto encodeKeyframeOnce = [&] {
+        if (!keyframe) {
+            auto encoded = std::make_shared<std::string>();
+            TerminalState joined;
+            encodeKeyframe(frame, *encoded, joined, *style);
+            if (havePrevious) {
+                encodeDeltaOnce();
+                encodeTerminalState(terminal, *encoded, joined, *style);
+            }
+            else {
+                terminal = joined;
+            }
+            bytesEncoded += encoded->size();
+            keyframe = std::move(encoded);
+        }
+    };
+
+    for (auto& spectator : spectators) {
+        if (!isConnected(spectator)) {
+            closeSpectator(spectator);
+            continue;
+        }
+
+        // Too far behind - drop what hasn't started sending and catch up with a keyframe.
+        // A partly sent message stays, so the stream never breaks off inside a sequence
+        if (spectator.queuedBytes > maxQueuedBytes) {
+            while (spectator.queue.size() > (spectator.sentOfFront > 0 ? 1u : 0u)) {
+                spectator.queuedBytes -= spectator.queue.back()->size();
+                spectator.queue.pop_back();
+            }
+            spectator.needsKeyframe = true;
+            ++resyncs;
+        }
+
+        if (spectator.needsKeyframe || !havePrevious) {
+            encodeKeyframeOnce();
+            enqueue(spectator, keyframe);
+            spectator.needsKeyframe = false;
+            ++keyframesSent;
+        }
+        else {
+            encodeDeltaOnce();
+            if (!delta->empty()) {
+                enqueue(spectator, delta);
+            }
+        }
+
+        if (!flush(spectator)) {
+            closeSpectator(spectator);
+        }
+    }
+
+    // Forget the spectators that left
+    spectators.erase(std::remove_if(spectators.begin(), spectators.end(), [](const Spectator& spectator) {
+        return spectator.socket == static_cast<std::uintptr_t>(INVALID_SOCKET);
+        }), spectators.end());
+
+    previous = frame;
+    havePrevious = true;
+}
+
+bool SpectatorServer::isListening() const { return listening; }
+std::size_t SpectatorServer::getSpectatorCount() const { return spectators.size(); }
+std::size_t SpectatorServer::getFramesPublished() const { return framesPublished; }
+std::size_t SpectatorServer::getKeyframesSent() const { return keyframesSent; }
+std::size_t SpectatorServer::getResyncs() const { return resyncs; }
+std::size_t SpectatorServer::getBytesEncoded() const { return bytesEncoded; }
@@ -0,0 +1,78 @@
+#ifndef SPECTATOR_SERVER_H
+#define SPECTATOR_SERVER_H
+
+#include "AnsiEncoder.h"
+#include "Frame.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Streams rendered frames to any number of TCP spectators (telnet or any raw TCP client in an
+// ANSI terminal). Each published frame is encoded once, as a delta against the previous one,
+// and the same buffer is queued for every spectator and sent with scatter-gather writes.
+// Sockets are non-blocking and publish() never waits: a spectator whose backlog grows past
+// the limit loses its queued frames and is resynchronised with a keyframe instead.
+class SpectatorServer {
+private:
+    using Message = std::shared_ptr<const std::string>;
+
+    struct Spectator {
+        std::uintptr_t socket;
+        std::deque<Message> queue;  // Messages not yet fully sent, oldest first
+        std::size_t sentOfFront;    // Bytes of the front message already sent
+        std::size_t queuedBytes;
+        bool needsKeyframe;
+    };
+
+    bool winsockStarted;        // Each successful start is matched by one cleanup
+    std::uintptr_t listenSocket;
+    bool listening;
+    std::size_t maxQueuedBytes;
+    const AnsiStyle* style;
+    std::vector<Spectator> spectators;
+
+    Frame previous;
+    bool havePrevious;
+    TerminalState terminal;     // Where the deltas so far leave every spectator's cursor and colour
+
+    // Totals for tuning and load testing
+    std::size_t framesPublished;
+    std::size_t keyframesSent;
+    std::size_t resyncs;
+    std::size_t bytesEncoded;
+
+    void acceptSpectators();
+    void enqueue(Spectator& spectator, const Message& message);
+    bool flush(Spectator& spectator);
+    bool isConnected(Spectator& spectator);
+    void closeSpectator(Spectator& spectator);
+
+public:
+    // Constructors - owns its sockets, so it cannot be copied or moved.
+    // Frames are spelled in the given style. Listens on the loopback interface unless anyInterface is set.
+    SpectatorServer(unsigned short port, const AnsiStyle& style = plainAnsiStyle(), bool anyInterface = false,
+        std::size_t maxQueuedBytes = 256 * 1024);
+    SpectatorServer(const SpectatorServer& other) = delete;
+    SpectatorServer(SpectatorServer&& other) = delete;
+    ~SpectatorServer();
+
+    // Assignment operator
+    SpectatorServer& operator=(const SpectatorServer& other) = delete;
+    SpectatorServer& operator=(SpectatorServer&& other) = delete;
+
+    bool isListening() const;
+
+    // Take in new spectators, encode the frame and send as much as each spectator accepts
+    void publish(const Frame& frame);
+
+    std::size_t getSpectatorCount() const;
+    std::size_t getFramesPublished() const;
+    std::size_t getKeyframesSent() const;
+    std::size_t getResyncs() const;
+    std::size_t getBytesEncoded() const;
+};
+
+#endif // SPECTATOR_SERVER_H
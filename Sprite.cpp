@@ -0,0 +1,52 @@
+#include "Sprite.h"
+
+#include <algorithm>
+
+constinit const Sprite SINGLE_CELL_SPRITE(0, 0, WHITE, { "#" });
+
+constinit const Sprite PLAYER_SHIP_SPRITE(2, 0, GREEN,
+    { "/=A=\\" },
+    { "2aea2" });
+
+constinit const Sprite PARTNER_SHIP_SPRITE(2, 0, CYAN,
+    { "/=B=\\" },
+    { "3beb3" });
+
+constinit const Sprite BOSS_SPRITE(3, 1, LIGHT_RED,
+    { " /MMM\\ ",
+      "<(o_o)>",
+      " V V V " },
+    { " cc5cc ",
+      "dcfcfcd",
+      " c c c " });
+
+// Getters
+int Sprite::getWidth() const { return width; }
+int Sprite::getHeight() const { return height; }
+int Sprite::getOriginX() const { return originX; }
+int Sprite::getOriginY() const { return originY; }
+std::uint64_t Sprite::getMask(int row) const { return masks[row]; }
+char Sprite::getGlyph(int col, int row) const { return glyphs[row][col]; }
+COLORS Sprite::getColor(int col, int row) const { return colors[row][col]; }
+
+// Mask overlap test
+bool Sprite::overlaps(int left, int top, const Sprite& other, int otherLeft, int otherTop) const {
+    // Bounding box reject first - the common case costs four compares
+    if (left + width <= otherLeft || otherLeft + other.width <= left ||
+        top + height <= otherTop || otherTop + other.height <= top) {
+        return false;
+    }
+
+    // Line the other sprite's rows up with ours and AND them; the box test keeps the shift below 64
+    int firstRow = std::max(top, otherTop);
+    int lastRow = std::min(top + height, otherTop + other.height);
+    int shift = otherLeft - left;
+    for (int y = firstRow; y < lastRow; ++y) {
+        std::uint64_t mine = masks[y - top];
+        std::uint64_t theirs = other.masks[y - otherTop];
+        if (shift >= 0 ? (mine & (theirs << shift)) : ((mine << -shift) & theirs)) {
+            return true;
+        }
+    }
+    return false;
+}
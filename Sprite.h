@@ -0,0 +1,82 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "ConsoleUtils.h"
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+const int SPRITE_MAX_WIDTH = 16;
+const int SPRITE_MAX_HEIGHT = 8;
+
+// Multi-cell image for entities bigger than one character.
+// Every row keeps a bitmask of its solid cells (bit 0 is the leftmost column) next to the
+// per-cell glyphs and colours, so collision is a few shifts and ANDs and drawing copies rows.
+class Sprite {
+private:
+    int width;
+    int height;
+    int originX;    // Cell that sits on the owning object's (x, y)
+    int originY;
+    std::array<std::uint64_t, SPRITE_MAX_HEIGHT> masks;
+    std::array<std::array<char, SPRITE_MAX_WIDTH>, SPRITE_MAX_HEIGHT> glyphs;
+    std::array<std::array<COLORS, SPRITE_MAX_WIDTH>, SPRITE_MAX_HEIGHT> colors;
+
+    static constexpr COLORS hexColor(char digit, COLORS fallback) {
+        if (digit >= '0' && digit <= '9') {
+            return static_cast<COLORS>(digit - '0');
+        }
+        if (digit >= 'a' && digit <= 'f') {
+            return static_cast<COLORS>(digit - 'a' + 10);
+        }
+        return fallback;
+    }
+
+public:
+    // Build a sprite from text rows, where spaces are transparent.
+    // colorRows optionally gives one hex digit (a COLORS value) per cell; other cells use color.
+    constexpr Sprite(int originX, int originY, COLORS color,
+        std::initializer_list<const char*> rows, std::initializer_list<const char*> colorRows = {})
+        : width(0), height(0), originX(originX), originY(originY), masks{}, glyphs{}, colors{} {
+
+        for (const char* row : rows) {
+            const char* colorRow = height < static_cast<int>(colorRows.size()) ? colorRows.begin()[height] : nullptr;
+            int col = 0;
+            for (; row[col] != '\0' && col < SPRITE_MAX_WIDTH; ++col) {
+                glyphs[height][col] = row[col];
+                colors[height][col] = colorRow ? hexColor(colorRow[col], color) : color;
+                if (row[col] != ' ') {
+                    masks[height] |= std::uint64_t(1) << col;
+                }
+            }
+            if (col > width) {
+                width = col;
+            }
+            if (++height == SPRITE_MAX_HEIGHT) {
+                break;
+            }
+        }
+    }
+
+    // Getters
+    int getWidth() const;
+    int getHeight() const;
+    int getOriginX() const;
+    int getOriginY() const;
+    std::uint64_t getMask(int row) const;
+    char getGlyph(int col, int row) const;
+    COLORS getColor(int col, int row) const;
+
+    // Check whether this sprite with its top-left corner at (left, top) overlaps other at (otherLeft, otherTop)
+    bool overlaps(int left, int top, const Sprite& other, int otherLeft, int otherTop) const;
+};
+
+// Shape used for plain single-character objects
+extern const Sprite SINGLE_CELL_SPRITE;
+
+// Sprites used by the game
+extern const Sprite PLAYER_SHIP_SPRITE;
+extern const Sprite PARTNER_SHIP_SPRITE;
+extern const Sprite BOSS_SPRITE;
+
+#endif // SPRITE_H
@@ -0,0 +1,57 @@
+#include "StatePublisher.h"
+#include <windows.h>
+
+// Constructor - creates the mapping, or attaches to one a previous run left open in a reader
+StatePublisher::StatePublisher() : mapping(nullptr), ring(nullptr), writing(nullptr) {
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(SharedStateRing), SHARED_STATE_NAME);
+    if (mapping == nullptr) {
+        return;
+    }
+    ring = static_cast<SharedStateRing*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedStateRing)));
+    if (ring == nullptr) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return;
+    }
+
+    // Start a new stream; readers of an old one see the tick count go back and resync
+    for (auto& slot : ring->slots) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+    }
+    ring->published.store(0, std::memory_order_relaxed);
+    ring->slotCount = SHARED_STATE_SLOTS;
+    ring->stateSize = sizeof(SharedState);
+    ring->version = SHARED_STATE_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->magic = SHARED_STATE_MAGIC;
+}
+
+// Destructor
+StatePublisher::~StatePublisher() {
+    if (ring != nullptr) {
+        UnmapViewOfFile(ring);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+}
+
+bool StatePublisher::isOpen() const {
+    return ring != nullptr;
+}
+
+// Mark the slot odd before touching it, so a reader copying it at the same time throws its copy away
+SharedState& StatePublisher::begin() {
+    std::uint64_t tick = ring->published.load(std::memory_order_relaxed);
+    writing = &ring->slots[tick % SHARED_STATE_SLOTS];
+    writing->sequence.store(writing->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    writing->state.tick = tick;
+    return writing->state;
+}
+
+void StatePublisher::commit() {
+    writing->sequence.store(writing->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    ring->published.fetch_add(1, std::memory_order_release);
+    writing = nullptr;
+}
@@ -0,0 +1,34 @@
+#ifndef STATE_PUBLISHER_H
+#define STATE_PUBLISHER_H
+
+#include "SharedState.h"
+
+// Writer side of the shared state ring. The game fills a slot in place between begin() and
+// commit(); readers in other processes never block it and it never waits for them.
+class StatePublisher {
+private:
+    void* mapping;
+    SharedStateRing* ring;
+    SharedStateSlot* writing;
+
+public:
+    // Constructors - owns the mapping, so it cannot be copied or moved
+    StatePublisher();
+    StatePublisher(const StatePublisher& other) = delete;
+    StatePublisher(StatePublisher&& other) = delete;
+    ~StatePublisher();
+
+    // Assignment operator
+    StatePublisher& operator=(const StatePublisher& other) = delete;
+    StatePublisher& operator=(StatePublisher&& other) = delete;
+
+    bool isOpen() const;
+
+    // Claim the slot for the next tick and return its state to fill in
+    SharedState& begin();
+
+    // Make the filled slot visible to readers
+    void commit();
+};
+
+#endif // STATE_PUBLISHER_H
@@ -0,0 +1,83 @@
+#include "StateReader.h"
+#include <windows.h>
+#include <cstring>
+
+// Attempts at reading the newest tick before giving up on a very fast writer
+static const int MAX_LATEST_ATTEMPTS = 4;
+
+// Constructor
+StateReader::StateReader() : mapping(nullptr), ring(nullptr) {}
+
+// Destructor
+StateReader::~StateReader() {
+    if (ring != nullptr) {
+        UnmapViewOfFile(ring);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+}
+
+// Map the ring read-only and check it was written by a compatible game
+bool StateReader::open() {
+    if (ring != nullptr) {
+        return true;
+    }
+    mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, SHARED_STATE_NAME);
+    if (mapping == nullptr) {
+        return false;
+    }
+    ring = static_cast<const SharedStateRing*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(SharedStateRing)));
+    bool compatible = ring != nullptr && ring->magic == SHARED_STATE_MAGIC && ring->version == SHARED_STATE_VERSION &&
+        ring->slotCount == SHARED_STATE_SLOTS && ring->stateSize == sizeof(SharedState);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (!compatible) {
+        if (ring != nullptr) {
+            UnmapViewOfFile(ring);
+            ring = nullptr;
+        }
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    return compatible;
+}
+
+bool StateReader::isOpen() const {
+    return ring != nullptr;
+}
+
+std::uint64_t StateReader::published() const {
+    return ring->published.load(std::memory_order_acquire);
+}
+
+// Seqlock read - the copy only counts if the slot's sequence was even and unchanged around it
+bool StateReader::read(std::uint64_t tick, SharedState& out) const {
+    if (tick >= published()) {
+        return false;
+    }
+    const SharedStateSlot& slot = ring->slots[tick % SHARED_STATE_SLOTS];
+
+    std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before % 2 != 0) {
+        return false;
+    }
+    std::memcpy(&out, &slot.state, sizeof(SharedState));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+    return before == after && out.tick == tick;
+}
+
+bool StateReader::readLatest(SharedState& out) const {
+    for (int attempt = 0; attempt < MAX_LATEST_ATTEMPTS; ++attempt) {
+        std::uint64_t count = published();
+        if (count == 0) {
+            return false;
+        }
+        if (read(count - 1, out)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,40 @@
+#ifndef STATE_READER_H
+#define STATE_READER_H
+
+#include "SharedState.h"
+
+// Reader side of the shared state ring, for tools running next to the game.
+// Reads are plain memory loads - no system calls and no locks - and never hold up the game.
+// A slot the game overwrites while it is being read is detected and the read reports failure.
+class StateReader {
+private:
+    void* mapping;
+    const SharedStateRing* ring;
+
+public:
+    // Constructors - owns the mapping, so it cannot be copied or moved
+    StateReader();
+    StateReader(const StateReader& other) = delete;
+    StateReader(StateReader&& other) = delete;
+    ~StateReader();
+
+    // Assignment operator
+    StateReader& operator=(const StateReader& other) = delete;
+    StateReader& operator=(StateReader&& other) = delete;
+
+    // Attach to the game's ring; false while no game is publishing
+    bool open();
+    bool isOpen() const;
+
+    // Number of ticks published so far; the newest is published() - 1
+    std::uint64_t published() const;
+
+    // Copy out the state of a tick. False if it is not published yet, has already been
+    // overwritten by a newer tick, or was overwritten during the copy
+    bool read(std::uint64_t tick, SharedState& out) const;
+
+    // Copy out the newest state, retrying while the game keeps overwriting it
+    bool readLatest(SharedState& out) const;
+};
+
+#endif // STATE_READER_H
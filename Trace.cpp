@@ -0,0 +1,99 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+bool traceEnabled = false;
+
+// Events kept per thread - a power of two, so wrapping is a mask
+static const std::size_t RING_CAPACITY = 1 << 16;
+
+struct TraceEvent {
+    const char* name;
+    std::int64_t time;      // Nanoseconds since startTracing()
+    char phase;             // 'B' or 'E'
+};
+
+// Single-writer ring; the owning thread publishes each event by bumping head, and the
+// writer of the trace only reads it once the traced threads are done
+struct TraceRing {
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<std::uint64_t> head;
+    int threadId;
+
+    explicit TraceRing(int threadId)
+        : events(new TraceEvent[RING_CAPACITY]), head(0), threadId(threadId) {}
+};
+
+static std::chrono::steady_clock::time_point traceStart;
+
+// Rings of every thread that has recorded something; only touched when a thread records its first event
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<TraceRing>> rings;
+
+// This thread's ring, registered on first use
+static TraceRing& threadRing() {
+    thread_local TraceRing* ring = nullptr;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(std::make_unique<TraceRing>(static_cast<int>(rings.size())));
+        ring = rings.back().get();
+    }
+    return *ring;
+}
+
+static void record(const char* name, char phase) {
+    TraceRing& ring = threadRing();
+    std::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceStart).count();
+
+    std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & (RING_CAPACITY - 1)] = TraceEvent{ name, time, phase };
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+// Start recording
+void startTracing() {
+    traceStart = std::chrono::steady_clock::now();
+    traceEnabled = true;
+}
+
+void traceBegin(const char* name) {
+    record(name, 'B');
+}
+
+void traceEnd(const char* name) {
+    record(name, 'E');
+}
+
+// Dump every ring, oldest event first
+bool writeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& ring : rings) {
+        std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        std::uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const TraceEvent& event = ring->events[i & (RING_CAPACITY - 1)];
+            file << (first ? "" : ",\n")
+                << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                << "\",\"ts\":" << event.time / 1000 << '.' << event.time % 1000 / 100
+                << ",\"pid\":1,\"tid\":" << ring->threadId << "}";
+            first = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,49 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+
+// Opt-in timeline tracing of game loop phases.
+// Every thread records begin/end events into its own fixed-size ring, keeping the most recent
+// events when a long session overflows it, and writeTrace() dumps them all as Chrome trace JSON
+// for chrome://tracing or Perfetto. While tracing is off a scope costs one branch on traceEnabled.
+
+// Set by startTracing(); read on every scope
+extern bool traceEnabled;
+
+// Turn tracing on - call before starting any threads that should be traced
+void startTracing();
+
+// Record the start and end of a phase; name must outlive the trace (string literals)
+void traceBegin(const char* name);
+void traceEnd(const char* name);
+
+// Write all recorded events as Chrome trace JSON, returns false if the file can't be written
+bool writeTrace(const std::string& path);
+
+// Traces the enclosing block
+class TraceScope {
+private:
+    const char* name;
+
+public:
+    // Constructors - tied to one block, so it cannot be copied or moved
+    explicit TraceScope(const char* name) : name(traceEnabled ? name : nullptr) {
+        if (this->name) {
+            traceBegin(name);
+        }
+    }
+    TraceScope(const TraceScope& other) = delete;
+    TraceScope(TraceScope&& other) = delete;
+    ~TraceScope() {
+        if (name) {
+            traceEnd(name);
+        }
+    }
+
+    // Assignment operator
+    TraceScope& operator=(const TraceScope& other) = delete;
+    TraceScope& operator=(TraceScope&& other) = delete;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,109 @@
+#include "Tuning.h"
+#include "Playfield.h"
+#include <charconv>
+#include <cstdlib>
+
+static const char* ENEMY_KEYS[TUNED_ENEMY_KINDS] = { "enemy1", "enemy2", "enemy3", "enemy4", "boss" };
+
+// Strip spaces and tabs from both ends
+static std::string_view trim(std::string_view text) {
+    std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static bool parseInt(std::string_view text, int minimum, int maximum, int& out) {
+    int value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size() || value < minimum || value > maximum) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+static bool parseProbability(std::string_view text, double& out) {
+    std::string copy(text);
+    char* end = nullptr;
+    double value = std::strtod(copy.c_str(), &end);
+    if (copy.empty() || *end != '\0' || !(value >= 0.0 && value <= 1.0)) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+// Set one value; false if the key is unknown or the value is out of range
+static bool applyValue(std::string_view key, std::string_view value, Tuning& tuning) {
+    if (key == "extraLifeScore") {
+        return parseInt(value, 0, 1000000000, tuning.extraLifeScore);
+    }
+    if (key == "tickMilliseconds") {
+        return parseInt(value, 1, 1000, tuning.tickMilliseconds);
+    }
+
+    std::size_t dot = key.find('.');
+    if (dot == std::string_view::npos) {
+        return false;
+    }
+    std::string_view group = key.substr(0, dot);
+    std::string_view field = key.substr(dot + 1);
+
+    // levelN - the formation has to fit on the screen with three columns per enemy
+    if (group.size() == 6 && group.substr(0, 5) == "level" && group[5] >= '1' && group[5] < '1' + TUNED_LEVELS) {
+        LevelTuning& level = tuning.levels[group[5] - '1'];
+        if (field == "enemyUpdateInterval") {
+            return parseInt(value, 1, 60000, level.enemyUpdateInterval);
+        }
+        if (field == "enemyShootInterval") {
+            return parseInt(value, 1, 60000, level.enemyShootInterval);
+        }
+        if (field == "enemyRows") {
+            return parseInt(value, 1, 10, level.enemyRows);
+        }
+        if (field == "enemyCols") {
+            return parseInt(value, 1, POLE_COLS / 3 - 1, level.enemyCols);
+        }
+        return false;
+    }
+
+    for (int kind = 0; kind < TUNED_ENEMY_KINDS; ++kind) {
+        if (group == ENEMY_KEYS[kind]) {
+            if (field == "points") {
+                return parseInt(value, 0, 1000000, tuning.enemies[kind].points);
+            }
+            if (field == "shootProbability") {
+                return parseProbability(value, tuning.enemies[kind].shootProbability);
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+bool parseTuning(std::string_view text, Tuning& tuning, std::string& error) {
+    // Work on a copy so a bad line leaves nothing half applied
+    Tuning parsed = tuning;
+    int lineNumber = 0;
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        ++lineNumber;
+
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        std::size_t equals = line.find('=');
+        if (equals == std::string_view::npos || !applyValue(trim(line.substr(0, equals)), trim(line.substr(equals + 1)), parsed)) {
+            error = "line " + std::to_string(lineNumber) + ": " + std::string(line);
+            return false;
+        }
+    }
+    tuning = parsed;
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <string>
+#include <string_view>
+
+// Enemy kinds in EnemyEntity order: EnemyType1..EnemyType4, then EnemyBoss
+const int TUNED_ENEMY_KINDS = 5;
+const int TUNED_LEVELS = 3;
+
+struct LevelTuning {
+    int enemyUpdateInterval;    // Milliseconds between formation steps
+    int enemyShootInterval;     // Milliseconds between enemy volleys
+    int enemyRows;
+    int enemyCols;
+};
+
+struct EnemyTuning {
+    int points;
+    double shootProbability;
+};
+
+// Gameplay values designers can change while the game runs (see TuningWatcher).
+// The defaults are the built-in game; a tuning file only has to name what it changes.
+struct Tuning {
+    LevelTuning levels[TUNED_LEVELS] = {
+        { 500, 1500, 5, 8 },
+        { 350, 1000, 6, 10 },
+        { 200, 750, 7, 12 },
+    };
+    EnemyTuning enemies[TUNED_ENEMY_KINDS] = {
+        { 10, 0.005 },
+        { 20, 0.01 },
+        { 30, 0.015 },
+        { 40, 0.02 },
+        { 150, 0.05 },
+    };
+    int extraLifeScore = 300;   // Score that awards the one extra life
+    int tickMilliseconds = 50;  // Real time per tick; the simulation still advances 50 ms, so this is the game speed
+};
+
+const Tuning DEFAULT_TUNING;
+
+// Apply "key = value" lines to tuning, e.g. "level2.enemyRows = 7" or "boss.points = 200".
+// '#' starts a comment. On an unknown key or a value out of range, tuning is left as it was
+// and error names the line.
+bool parseTuning(std::string_view text, Tuning& tuning, std::string& error);
+
+#endif // TUNING_H
@@ -0,0 +1,125 @@
+#include "TuningWatcher.h"
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+// Editors often write a file in several steps; wait this long after a change before reading it
+static const std::chrono::milliseconds SETTLE_TIME(50);
+
+// Constructor - loads the file once before the game starts, then watches it
+TuningWatcher::TuningWatcher(const std::string& path)
+    : path(path), latest(nullptr), acknowledged(nullptr), reloadCount(0), lastReloadFailed(false), change(INVALID_HANDLE_VALUE), stopEvent(nullptr) {
+    std::size_t slash = path.find_last_of("\\/");
+    directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+
+    // Armed before the first load, so a save right after it is not missed
+    change = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+
+    versions.push_back(std::make_unique<Tuning>(DEFAULT_TUNING));
+    latest.store(versions.back().get(), std::memory_order_release);
+    reload();
+
+    stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (change != INVALID_HANDLE_VALUE && stopEvent != nullptr) {
+        watcher = std::thread(&TuningWatcher::watchLoop, this);
+    }
+}
+
+// Destructor
+TuningWatcher::~TuningWatcher() {
+    if (watcher.joinable()) {
+        SetEvent(stopEvent);
+        watcher.join();
+    }
+    if (stopEvent != nullptr) {
+        CloseHandle(stopEvent);
+    }
+    if (change != INVALID_HANDLE_VALUE) {
+        FindCloseChangeNotification(change);
+    }
+}
+
+// Watch thread - any change in the directory triggers a reload, which ignores files other than ours
+void TuningWatcher::watchLoop() {
+    HANDLE handles[2] = { stopEvent, change };
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1) {
+        if (WaitForSingleObject(stopEvent, static_cast<DWORD>(SETTLE_TIME.count())) == WAIT_OBJECT_0) {
+            break;
+        }
+        // Rearm before reading, so a save during the read triggers another reload
+        FindNextChangeNotification(change);
+        reload();
+    }
+}
+
+// Read and parse the file; publishes a new version only if its text changed and it parsed
+bool TuningWatcher::reload() {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    std::string contents = text.str();
+    if (reloadCount.load(std::memory_order_relaxed) > 0 && contents == loadedText) {
+        // Saved back to what is already loaded, e.g. after fixing a mistake
+        lastReloadFailed.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Always parsed on top of the defaults, so removing a line restores its default
+    auto tuning = std::make_unique<Tuning>(DEFAULT_TUNING);
+    std::string error;
+    if (!parseTuning(contents, *tuning, error)) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        lastError = path + " " + error;
+        lastReloadFailed.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    loadedText = std::move(contents);
+    releaseOldVersions();
+    versions.push_back(std::move(tuning));
+    latest.store(versions.back().get(), std::memory_order_release);
+    reloadCount.fetch_add(1, std::memory_order_relaxed);
+    lastReloadFailed.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(errorMutex);
+    lastError.clear();
+    return true;
+}
+
+// Versions before the acknowledged one can no longer be handed out or in use. Newer ones that
+// were never acknowledged stay, since the reader may have just loaded one of them.
+void TuningWatcher::releaseOldVersions() {
+    const Tuning* inUse = acknowledged.load(std::memory_order_acquire);
+    auto found = std::find_if(versions.begin(), versions.end(), [inUse](const std::unique_ptr<Tuning>& version) {
+        return version.get() == inUse;
+        });
+    if (found != versions.end()) {
+        versions.erase(versions.begin(), found);
+    }
+}
+
+const Tuning* TuningWatcher::current() const {
+    return latest.load(std::memory_order_acquire);
+}
+
+void TuningWatcher::acknowledge(const Tuning* inUse) {
+    acknowledged.store(inUse, std::memory_order_release);
+}
+
+int TuningWatcher::getReloadCount() const {
+    return reloadCount.load(std::memory_order_relaxed);
+}
+
+bool TuningWatcher::hasError() const {
+    return lastReloadFailed.load(std::memory_order_relaxed);
+}
+
+std::string TuningWatcher::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return lastError;
+}
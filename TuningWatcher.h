@@ -0,0 +1,69 @@
+#ifndef TUNING_WATCHER_H
+#define TUNING_WATCHER_H
+
+#include "Tuning.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads a tuning file and reloads it whenever it changes on disk.
+// A background thread waits on a change notification for the file's directory, parses the new
+// file and publishes it by swapping one pointer. The game reads current() once per tick, a
+// single atomic load, so a reload takes effect between ticks and never blocks the game.
+// A version stays valid until the reader acknowledges a newer one; the watch thread frees the
+// versions older than the acknowledged one on its next reload, so a reader that acknowledges
+// what it picks up keeps at most a few versions alive however many reloads a sweep makes.
+class TuningWatcher {
+private:
+    std::string path;
+    std::string directory;
+
+    std::atomic<const Tuning*> latest;
+    std::atomic<const Tuning*> acknowledged;            // The oldest version the reader still uses
+    std::vector<std::unique_ptr<Tuning>> versions;     // Oldest first; only touched by the constructor and the watch thread
+    std::string loadedText;
+    std::atomic<int> reloadCount;
+    std::atomic<bool> lastReloadFailed;
+
+    mutable std::mutex errorMutex;
+    std::string lastError;
+
+    void* change;       // Change notification for the file's directory
+    void* stopEvent;
+    std::thread watcher;
+
+    void watchLoop();
+    bool reload();
+
+    // Free the versions older than the acknowledged one
+    void releaseOldVersions();
+
+public:
+    // Constructors - the watcher owns a thread, so it cannot be copied or moved
+    explicit TuningWatcher(const std::string& path);
+    TuningWatcher(const TuningWatcher& other) = delete;
+    TuningWatcher(TuningWatcher&& other) = delete;
+    ~TuningWatcher();
+
+    // Assignment operator
+    TuningWatcher& operator=(const TuningWatcher& other) = delete;
+    TuningWatcher& operator=(TuningWatcher&& other) = delete;
+
+    // The newest tuning that parsed; the defaults until the file does
+    const Tuning* current() const;
+
+    // The reader is done with every version older than this one, which came from current()
+    void acknowledge(const Tuning* inUse);
+
+    // Successful loads, including the first
+    int getReloadCount() const;
+
+    // Whether the file as it is now failed to parse, and why
+    bool hasError() const;
+    std::string getLastError() const;
+};
+
+#endif // TUNING_WATCHER_H
@@ -0,0 +1,194 @@
+#include "VecEnv.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Coroutine frames per headless game - a batch holds many games, so keep them small
+static const std::size_t ENV_MAX_SCRIPTS = 256;
+
+// SplitMix64 step, used to derive independent seeds per env and per episode
+static std::uint64_t mixSeed(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Constructor
+VecEnv::VecEnv(int envCount, int threadCount, const GameOptions& options)
+    : marked(envCount), episodeSeeds(envCount, 0), lastScores(envCount, 0), lastLives(envCount, 0),
+    threadCount(std::max(1, std::min(threadCount, envCount))),
+    startBarrier(this->threadCount), doneBarrier(this->threadCount),
+    command(COMMAND_STEP), resetSeed(0),
+    actions(nullptr), observations(nullptr), previousObservations(nullptr), rewards(nullptr), dones(nullptr) {
+
+    GameOptions envOptions = options;
+    envOptions.headless = true;
+    envOptions.maxScripts = std::min(options.maxScripts, ENV_MAX_SCRIPTS);
+
+    games.reserve(envCount);
+    for (int env = 0; env < envCount; ++env) {
+        envOptions.seed = mixSeed(env + 1);
+        games.push_back(std::make_unique<Game>(envOptions));
+        marked[env].reserve(1024);
+    }
+
+    // The calling thread handles slice 0 itself
+    for (int thread = 1; thread < this->threadCount; ++thread) {
+        workers.emplace_back(&VecEnv::workerLoop, this, thread);
+    }
+}
+
+// Destructor
+VecEnv::~VecEnv() {
+    command = COMMAND_STOP;
+    startBarrier.arrive_and_wait();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Worker threads wait for a batch, run their slice and report back
+void VecEnv::workerLoop(int thread) {
+    for (;;) {
+        startBarrier.arrive_and_wait();
+        if (command == COMMAND_STOP) {
+            return;
+        }
+        runSlice(thread);
+        doneBarrier.arrive_and_wait();
+    }
+}
+
+// Process a contiguous range of envs
+void VecEnv::runSlice(int thread) {
+    std::size_t envCount = games.size();
+    std::size_t first = envCount * thread / threadCount;
+    std::size_t last = envCount * (thread + 1) / threadCount;
+
+    for (std::size_t env = first; env < last; ++env) {
+        if (command == COMMAND_RESET) {
+            resetEnv(env, mixSeed(resetSeed + env));
+        }
+        else {
+            stepEnv(env);
+        }
+    }
+}
+
+// Start a new episode in one env
+void VecEnv::resetEnv(std::size_t env, std::uint64_t seed) {
+    Game& game = *games[env];
+    episodeSeeds[env] = seed;
+    game.reset(seed);
+    lastScores[env] = game.getPlayer().getScore();
+    lastLives[env] = game.getPlayer().getLives();
+    writeObservation(env, true);
+}
+
+// Step one env, resetting it when its game ends
+void VecEnv::stepEnv(std::size_t env) {
+    Game& game = *games[env];
+
+    int action = actions[env];
+    if (action < 0 || action >= ACTION_COUNT) {
+        action = ACTION_NONE;
+    }
+    bool alive = game.step(static_cast<Action>(action));
+
+    const Player& player = game.getPlayer();
+    int livesLost = std::max(0, lastLives[env] - player.getLives());
+    rewards[env] = static_cast<float>(player.getScore() - lastScores[env]) - LIFE_LOST_PENALTY * livesLost;
+    dones[env] = alive ? 0 : 1;
+
+    if (!alive) {
+        resetEnv(env, mixSeed(episodeSeeds[env]));
+        return;
+    }
+
+    lastScores[env] = player.getScore();
+    lastLives[env] = player.getLives();
+    writeObservation(env, observations != previousObservations);
+}
+
+// Write one env's occupancy planes
+void VecEnv::writeObservation(std::size_t env, bool fullClear) {
+    std::uint8_t* planes = observations + env * OBSERVATION_SIZE;
+    std::vector<std::uint32_t>& cells = marked[env];
+
+    if (fullClear) {
+        std::memset(planes, 0, OBSERVATION_SIZE);
+    }
+    else {
+        for (std::uint32_t offset : cells) {
+            planes[offset] = 0;
+        }
+    }
+    cells.clear();
+
+    auto mark = [&](int plane, int x, int y) {
+        if (x < 0 || x >= POLE_COLS || y < 0 || y >= POLE_ROWS) {
+            return;
+        }
+        std::uint32_t offset = static_cast<std::uint32_t>(plane * PLANE_SIZE + y * POLE_COLS + x);
+        planes[offset] = 1;
+        cells.push_back(offset);
+    };
+
+    // Every solid cell of an object, following its sprite mask when it has one
+    auto markObject = [&](int plane, const GameObject& object) {
+        const Sprite* sprite = object.getSprite();
+        if (!sprite) {
+            mark(plane, object.getX(), object.getY());
+            return;
+        }
+        for (int row = 0; row < sprite->getHeight(); ++row) {
+            std::uint64_t mask = sprite->getMask(row);
+            for (int col = 0; mask != 0; ++col, mask >>= 1) {
+                if (mask & 1) {
+                    mark(plane, object.getLeft() + col, object.getTop() + row);
+                }
+            }
+        }
+    };
+
+    const Game& game = *games[env];
+    markObject(PLANE_PLAYER, game.getPlayer());
+    for (const auto& enemy : game.getEnemies()) {
+        markObject(PLANE_ENEMY_TYPE1 + static_cast<int>(enemy.index()), asEnemy(enemy));
+    }
+    for (const auto& bullet : game.getBullets()) {
+        markObject(bullet.getDirection() < 0 ? PLANE_PLAYER_BULLETS : PLANE_ENEMY_BULLETS, bullet);
+    }
+}
+
+// Reset every env
+void VecEnv::reset(std::uint64_t seed, std::uint8_t* observations) {
+    command = COMMAND_RESET;
+    resetSeed = seed;
+    this->observations = observations;
+
+    startBarrier.arrive_and_wait();
+    runSlice(0);
+    doneBarrier.arrive_and_wait();
+
+    previousObservations = observations;
+}
+
+// Step every env
+void VecEnv::step(const int* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones) {
+    command = COMMAND_STEP;
+    this->actions = actions;
+    this->observations = observations;
+    this->rewards = rewards;
+    this->dones = dones;
+
+    startBarrier.arrive_and_wait();
+    runSlice(0);
+    doneBarrier.arrive_and_wait();
+
+    previousObservations = observations;
+}
+
+int VecEnv::getEnvCount() const { return static_cast<int>(games.size()); }
+const Game& VecEnv::getGame(int env) const { return *games[env]; }
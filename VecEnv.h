@@ -0,0 +1,93 @@
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include "Game.h"
+#include <barrier>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Observation planes - one byte per cell, 1 where the cell is occupied
+enum ObservationPlane {
+    PLANE_PLAYER = 0,
+    PLANE_ENEMY_TYPE1,
+    PLANE_ENEMY_TYPE2,
+    PLANE_ENEMY_TYPE3,
+    PLANE_ENEMY_TYPE4,
+    PLANE_ENEMY_BOSS,
+    PLANE_PLAYER_BULLETS,
+    PLANE_ENEMY_BULLETS,
+    PLANE_COUNT
+};
+
+const std::size_t PLANE_SIZE = static_cast<std::size_t>(POLE_ROWS) * POLE_COLS;
+const std::size_t OBSERVATION_SIZE = PLANE_COUNT * PLANE_SIZE;
+
+// Reward shaping - score gained in a step minus this much per life lost
+const float LIFE_LOST_PENALTY = 50.0f;
+
+// Batch of headless games stepped in lockstep, for training bots against the game.
+// Observations go straight into a caller-provided buffer laid out as [env][plane][row][col].
+// Only the cells set on the previous call are cleared, so the buffer must not be written
+// by the caller between calls (passing a different buffer is fine, it gets cleared in full).
+// Finished games are reset automatically with a fresh seed, and the observation returned
+// for them is the first one of the new episode.
+class VecEnv {
+private:
+    enum Command {
+        COMMAND_RESET,
+        COMMAND_STEP,
+        COMMAND_STOP
+    };
+
+    std::vector<std::unique_ptr<Game>> games;
+    std::vector<std::vector<std::uint32_t>> marked;    // Observation offsets set for each env last time
+    std::vector<std::uint64_t> episodeSeeds;
+    std::vector<int> lastScores;
+    std::vector<int> lastLives;
+
+    int threadCount;
+    std::vector<std::thread> workers;
+    std::barrier<> startBarrier;
+    std::barrier<> doneBarrier;
+
+    // Arguments of the batch being processed, written before startBarrier releases the workers
+    Command command;
+    std::uint64_t resetSeed;
+    const int* actions;
+    std::uint8_t* observations;
+    std::uint8_t* previousObservations;
+    float* rewards;
+    std::uint8_t* dones;
+
+    void workerLoop(int thread);
+    void runSlice(int thread);
+    void resetEnv(std::size_t env, std::uint64_t seed);
+    void stepEnv(std::size_t env);
+    void writeObservation(std::size_t env, bool fullClear);
+
+public:
+    // Constructors - owns its games and worker threads, so it cannot be copied or moved
+    VecEnv(int envCount, int threadCount, const GameOptions& options = GameOptions());
+    VecEnv(const VecEnv& other) = delete;
+    VecEnv(VecEnv&& other) = delete;
+    ~VecEnv();
+
+    // Assignment operator
+    VecEnv& operator=(const VecEnv& other) = delete;
+    VecEnv& operator=(VecEnv&& other) = delete;
+
+    // Start a new episode in every env; env i is seeded from seed and i.
+    // observations must hold getEnvCount() * OBSERVATION_SIZE bytes.
+    void reset(std::uint64_t seed, std::uint8_t* observations);
+
+    // Advance every env by one tick. actions holds one Action per env;
+    // rewards and dones receive one value per env.
+    void step(const int* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones);
+
+    int getEnvCount() const;
+    const Game& getGame(int env) const;
+};
+
+#endif // VEC_ENV_H
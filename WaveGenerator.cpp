@@ -0,0 +1,94 @@
+#include "WaveGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+// Formation outlines a wave can be built in
+enum FormationShape {
+    SHAPE_BLOCK = 0,
+    SHAPE_DIAMOND,
+    SHAPE_CHECKER,
+    SHAPE_VEE,
+    SHAPE_COUNT
+};
+
+static const char* const SHAPE_NAMES[SHAPE_COUNT] = { "Block", "Diamond", "Checkerboard", "Vee" };
+
+// Check whether a formation slot is filled for a given shape
+static bool slotFilled(FormationShape shape, int row, int col, int rows, int cols) {
+    switch (shape) {
+    case SHAPE_DIAMOND: {
+        double across = std::abs(col - cols / 2) / std::max(1.0, cols / 2.0);
+        double down = std::abs(row - rows / 2) / std::max(1.0, rows / 2.0);
+        return across + down <= 1.0;
+    }
+    case SHAPE_CHECKER:
+        return (row + col) % 2 == 0;
+    case SHAPE_VEE:
+        return std::abs(col - cols / 2) >= row;
+    default:
+        return true;
+    }
+}
+
+// Difficulty curve
+double waveDifficulty(int level) {
+    return 1.0 - std::exp(-(level - 1) / 6.0);
+}
+
+// Build a wave
+Wave generateWave(std::uint64_t seed, int level) {
+    std::mt19937_64 rng(seed ^ (static_cast<std::uint64_t>(level) * 0x9E3779B97F4A7C15ull));
+    double difficulty = waveDifficulty(level);
+
+    Wave wave;
+    wave.level = level;
+    wave.enemyUpdateInterval = std::chrono::milliseconds(500 - static_cast<int>(380 * difficulty));
+    wave.enemyShootInterval = std::chrono::milliseconds(1500 - static_cast<int>(1100 * difficulty));
+    wave.enemyRows = 4 + static_cast<int>(4 * difficulty) + static_cast<int>(rng() % 2);
+    wave.enemyCols = 8 + static_cast<int>(10 * difficulty) + static_cast<int>(rng() % 3);
+
+    FormationShape shape = static_cast<FormationShape>(rng() % SHAPE_COUNT);
+    wave.name = std::string(SHAPE_NAMES[shape]) + " formation";
+
+    // Tougher enemy types become more likely as difficulty rises
+    std::uniform_real_distribution<> roll(0.0, 1.0);
+    int startX = (POLE_COLS - (wave.enemyCols * 3)) / 2;
+    int startY = 5;
+    wave.enemies.reserve(wave.enemyRows * wave.enemyCols + 3);
+
+    for (int row = 0; row < wave.enemyRows; ++row) {
+        for (int col = 0; col < wave.enemyCols; ++col) {
+            if (!slotFilled(shape, row, col, wave.enemyRows, wave.enemyCols)) {
+                continue;
+            }
+
+            int x = startX + col * 3;
+            int y = startY + row * 2;
+            double tier = roll(rng) * 0.6 + difficulty * 0.4 + (1.0 - static_cast<double>(row) / wave.enemyRows) * 0.3;
+            if (tier > 0.95) {
+                wave.enemies.emplace_back(std::in_place_type<EnemyType4>, x, y);
+            }
+            else if (tier > 0.75) {
+                wave.enemies.emplace_back(std::in_place_type<EnemyType3>, x, y);
+            }
+            else if (tier > 0.45) {
+                wave.enemies.emplace_back(std::in_place_type<EnemyType2>, x, y);
+            }
+            else {
+                wave.enemies.emplace_back(std::in_place_type<EnemyType1>, x, y);
+            }
+        }
+    }
+
+    // Bosses lead the formation from level 2, one more every five levels
+    int bosses = level >= 2 ? std::min(3, 1 + level / 5) : 0;
+    for (int i = 0; i < bosses; ++i) {
+        int x = POLE_COLS / 2 + (i - bosses / 2) * 12;
+        wave.enemies.emplace_back(std::in_place_type<EnemyBoss>, x, startY - 3);
+    }
+
+    return wave;
+}
@@ -0,0 +1,27 @@
+#ifndef WAVE_GENERATOR_H
+#define WAVE_GENERATOR_H
+
+#include "Entity.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A fully built wave, ready to be moved into the game
+struct Wave {
+    int level;
+    std::string name;
+    std::chrono::milliseconds enemyUpdateInterval;
+    std::chrono::milliseconds enemyShootInterval;
+    int enemyRows;
+    int enemyCols;
+    std::vector<EnemyEntity> enemies;
+};
+
+// Difficulty of a level on the endless curve, rising from 0 towards 1
+double waveDifficulty(int level);
+
+// Procedurally build the wave for a level; the same seed and level always give the same wave
+Wave generateWave(std::uint64_t seed, int level);
+
+#endif // WAVE_GENERATOR_H
@@ -1,9 +1,146 @@
 #include "Game.h"
+#include "Netplay.h"
+#include "Soak.h"
+#include "Trace.h"
 
-int main() {
-    // Create a game instance and run it
-    Game game;
-    game.run();
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
 
-    return 0;
+int main(int argc, char* argv[]) {
+    // --endless keeps generating new waves instead of stopping after level 3
+    // --autopilot lets the built-in bot play
+    // --soak [games] plays games back to back with the bot, as fast as possible, and reports
+    // --seed <n> fixes the seed of every random decision
+    // --threads <n> runs large ticks as a job graph on n threads
+    // --trace <file> records game loop phases and writes them as Chrome trace JSON on exit
+    // --assert-no-alloc aborts as soon as a steady-state tick allocates (GAME_COUNT_ALLOCATIONS builds)
+    // --spectate <port> streams the game as ANSI text to TCP spectators on localhost
+    // --share-state publishes every tick into a shared-memory ring for external tools
+    // --record <file> records the session; tools/RecordingToCast turns it into an asciicast
+    // --journal <dir> writes an event journal per run into dir; tools/JournalQuery aggregates them
+    // --scores <file> keeps high scores in file (highscores.dat when playing, none for soak runs)
+    // --player <name> records runs under name instead of the user name
+    // --tuning <file> loads tuning values from file and reloads them whenever it is saved
+    // --vt draws with ANSI escape sequences (Windows 10 console or Windows Terminal)
+    // --truecolor uses 24-bit colour and Unicode glyphs for --vt, spectators and recordings
+    // --host <port> / --join <port> play two-player co-op over localhost, as player 1 or player 2
+    // --net-delay <ms> and --net-loss <percent> impair this side's outgoing netplay packets
+    GameOptions options;
+    NetplayOptions netOptions;
+    bool netplay = false;
+    int soakGames = 0;
+    std::string tracePath;
+    std::string playerName;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--endless") == 0) {
+            options.endless = true;
+        }
+        else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            options.autopilot = true;
+        }
+        else if (std::strcmp(argv[i], "--soak") == 0) {
+            soakGames = 1000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                soakGames = std::atoi(argv[++i]);
+            }
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.workerThreads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--assert-no-alloc") == 0) {
+            options.assertNoAllocations = true;
+        }
+        else if (std::strcmp(argv[i], "--spectate") == 0 && i + 1 < argc) {
+            options.spectatorPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--share-state") == 0) {
+            options.shareState = true;
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            options.journalDirectory = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scores") == 0 && i + 1 < argc) {
+            options.scoreFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tuning") == 0 && i + 1 < argc) {
+            options.tuningPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--vt") == 0) {
+            options.virtualTerminal = true;
+        }
+        else if (std::strcmp(argv[i], "--truecolor") == 0) {
+            options.richOutput = true;
+        }
+        else if (std::strcmp(argv[i], "--player") == 0 && i + 1 < argc) {
+            playerName = argv[++i];
+        }
+        else if ((std::strcmp(argv[i], "--host") == 0 || std::strcmp(argv[i], "--join") == 0) && i + 1 < argc) {
+            netplay = true;
+            netOptions.player = argv[i][2] == 'h' ? 1 : 2;
+            netOptions.port = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--net-delay") == 0 && i + 1 < argc) {
+            netOptions.delayMilliseconds = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--net-loss") == 0 && i + 1 < argc) {
+            netOptions.lossPercent = std::atoi(argv[++i]);
+        }
+    }
+
+    if (options.scoreFile.empty() && soakGames == 0 && !netplay) {
+        options.scoreFile = "highscores.dat";
+    }
+    if (playerName.empty()) {
+        const char* userName = std::getenv("USERNAME");
+        playerName = userName != nullptr && userName[0] != '\0' ? userName : "player";
+    }
+    options.playerName = playerName;
+
+    if (options.assertNoAllocations && !ALLOCATION_COUNTING) {
+        std::cerr << "--assert-no-alloc has no effect without GAME_COUNT_ALLOCATIONS" << std::endl;
+    }
+
+    // Tracing has to be on before the game starts its worker threads
+    if (!tracePath.empty()) {
+        startTracing();
+    }
+
+    int result = 0;
+    if (soakGames > 0) {
+        SoakReport report = runSoak(soakGames, options);
+        printSoakReport(report, std::cout);
+        result = report.violationCount == 0 ? 0 : 1;
+    }
+    else if (netplay) {
+        // In netplay --autopilot flies this side's ship
+        netOptions.autopilot = options.autopilot;
+        NetplaySession session(netOptions, options);
+        NetplayReport report = session.run();
+        printNetplayReport(report, std::cout);
+        result = report.desynced ? 1 : 0;
+    }
+    else {
+        // Create a game instance and run it
+        Game game(options);
+        game.run();
+    }
+
+    if (!tracePath.empty() && !writeTrace(tracePath)) {
+        std::cerr << "Could not write trace to " << tracePath << std::endl;
+    }
+    if (ALLOCATION_COUNTING) {
+        printAllocationReport(std::cout);
+    }
+    return result;
 }
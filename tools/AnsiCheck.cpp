@@ -0,0 +1,120 @@
+// Checks that ANSI messages decode back to the frames they were encoded from, in both styles:
+// a keyframe, then a delta every tick carrying the terminal state along, and receivers joining
+// part way with a keyframe aligned to the stream's state. After every message the decoded frame
+// must match the game's frame, and the decoder must leave the cursor and colour where the
+// encoder believes they are.
+// Build from the repository root together with the game sources (everything except main.cpp), e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\AnsiCheck.cpp AnsiEncoder.cpp Frame.cpp Game.cpp ...
+// Usage: AnsiCheck [ticks] [seed]
+// Exits with 1 if any check fails.
+
+#include "AnsiEncoder.h"
+#include "Game.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Ticks between receivers joining the stream
+static const int JOIN_EVERY = 500;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Frames look the same when every glyph matches, and the colour of every glyph that isn't blank
+static bool sameFrame(const Frame& a, const Frame& b) {
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        for (int x = 0; x < POLE_COLS; ++x) {
+            const Cell& left = a.at(x, y);
+            const Cell& right = b.at(x, y);
+            if (left.glyph != right.glyph || (left.glyph != ' ' && left.color != right.color)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The encoder's idea of the terminal only holds where it knows it
+static bool sameState(const TerminalState& encoder, const TerminalState& decoder) {
+    return (encoder.x < 0 || (encoder.x == decoder.x && encoder.y == decoder.y)) &&
+        (encoder.color < 0 || encoder.color == decoder.color);
+}
+
+// Stream one game in a style to a receiver from the start and to ones joining later
+static void checkStyle(const AnsiStyle& style, const std::string& name, int ticks, std::uint64_t seed) {
+    GameOptions options;
+    options.headless = true;
+    options.autopilot = true;
+    options.seed = seed;
+    Game game(options);
+
+    TerminalState sender;
+    Frame previous;
+    Frame received;
+    TerminalState receiver;
+    Frame joined;
+    TerminalState joiner;
+    bool haveJoiner = false;
+    std::string message;
+    std::size_t deltaBytes = 0;
+    int deltas = 0;
+
+    for (int tick = 0; tick < ticks && game.step(ACTION_NONE) && failures == 0; ++tick) {
+        const Frame& frame = game.drawFrame();
+        message.clear();
+        if (tick == 0) {
+            encodeKeyframe(frame, message, sender, style);
+        }
+        else {
+            encodeDelta(previous, frame, message, sender, style);
+            deltaBytes += message.size();
+            ++deltas;
+        }
+        previous = frame;
+
+        decodeAnsi(message, received, receiver);
+        check(sameFrame(received, frame), name + ": frame differs after the message for tick " + std::to_string(tick));
+        check(sameState(sender, receiver), name + ": terminal state differs after the message for tick " + std::to_string(tick));
+
+        // A receiver that joined earlier follows the same deltas
+        if (haveJoiner) {
+            decodeAnsi(message, joined, joiner);
+            check(sameFrame(joined, frame), name + ": late receiver's frame differs at tick " + std::to_string(tick));
+        }
+
+        // A new receiver starts from a keyframe, moved to where the stream's deltas pick up
+        if (tick > 0 && tick % JOIN_EVERY == 0) {
+            std::string keyframe;
+            TerminalState aligned;
+            encodeKeyframe(frame, keyframe, aligned, style);
+            encodeTerminalState(sender, keyframe, aligned, style);
+            joined = Frame();
+            joiner = TerminalState();
+            decodeAnsi(keyframe, joined, joiner);
+            check(sameFrame(joined, frame), name + ": keyframe differs at tick " + std::to_string(tick));
+            check(sameState(sender, joiner), name + ": keyframe does not leave the stream's terminal state at tick " + std::to_string(tick));
+            haveJoiner = true;
+        }
+    }
+
+    std::cout << name << ": " << deltas << " deltas, " << deltaBytes << " bytes" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 3000;
+    std::uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 7;
+
+    checkStyle(plainAnsiStyle(), "plain", ticks, seed);
+    checkStyle(richAnsiStyle(), "rich", ticks, seed);
+
+    std::cout << (failures == 0 ? "All ANSI checks passed" : "ANSI checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
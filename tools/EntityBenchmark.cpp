@@ -0,0 +1,86 @@
+// Compares virtual dispatch through unique_ptr<Enemy> with the static-dispatch EnemyEntity model.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /GL /EHsc /I. tools\EntityBenchmark.cpp Enemy.cpp Bullet.cpp GameObject.cpp ConsoleUtils.cpp
+
+#include "Entity.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+const int ENTITY_COUNT = 100000;
+const int ITERATIONS = 200;
+
+// Fill both containers with the same mix of enemy types
+static void buildFormations(std::vector<std::unique_ptr<Enemy>>& virtualEnemies, std::vector<EnemyEntity>& staticEnemies) {
+    for (int i = 0; i < ENTITY_COUNT; ++i) {
+        int x = i % POLE_COLS;
+        int y = i / POLE_COLS;
+        switch (i % 4) {
+        case 0:
+            virtualEnemies.push_back(std::make_unique<EnemyType1>(x, y));
+            staticEnemies.emplace_back(std::in_place_type<EnemyType1>, x, y);
+            break;
+        case 1:
+            virtualEnemies.push_back(std::make_unique<EnemyType2>(x, y));
+            staticEnemies.emplace_back(std::in_place_type<EnemyType2>, x, y);
+            break;
+        case 2:
+            virtualEnemies.push_back(std::make_unique<EnemyType3>(x, y));
+            staticEnemies.emplace_back(std::in_place_type<EnemyType3>, x, y);
+            break;
+        default:
+            virtualEnemies.push_back(std::make_unique<EnemyType4>(x, y));
+            staticEnemies.emplace_back(std::in_place_type<EnemyType4>, x, y);
+            break;
+        }
+    }
+}
+
+// Time ITERATIONS update passes and return nanoseconds per entity update
+template <typename Pass>
+static double measure(Pass pass) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        pass();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (static_cast<double>(ITERATIONS) * ENTITY_COUNT);
+}
+
+int main() {
+    std::vector<std::unique_ptr<Enemy>> virtualEnemies;
+    std::vector<EnemyEntity> staticEnemies;
+    virtualEnemies.reserve(ENTITY_COUNT);
+    staticEnemies.reserve(ENTITY_COUNT);
+    buildFormations(virtualEnemies, staticEnemies);
+
+    double virtualTime = measure([&]() {
+        for (auto& enemy : virtualEnemies) {
+            enemy->update();
+        }
+        });
+
+    double staticTime = measure([&]() {
+        for (auto& enemy : staticEnemies) {
+            updateEntity(enemy);
+        }
+        });
+
+    // Checksum keeps the update loops from being optimized away and shows both models agree
+    long long virtualSum = 0;
+    long long staticSum = 0;
+    for (int i = 0; i < ENTITY_COUNT; ++i) {
+        virtualSum += virtualEnemies[i]->getX() + virtualEnemies[i]->getY();
+        staticSum += asEnemy(staticEnemies[i]).getX() + asEnemy(staticEnemies[i]).getY();
+    }
+
+    std::cout << "Entities: " << ENTITY_COUNT << ", iterations: " << ITERATIONS << std::endl;
+    std::cout << "Virtual (unique_ptr<Enemy>): " << virtualTime << " ns/update" << std::endl;
+    std::cout << "Static (EnemyEntity):        " << staticTime << " ns/update" << std::endl;
+    std::cout << "Checksums: " << virtualSum << " / " << staticSum
+        << (virtualSum == staticSum ? " (match)" : " (MISMATCH)") << std::endl;
+
+    return virtualSum == staticSum ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// Measures VecEnv throughput with random actions, in env steps per second for each env count.
+// Build from the repository root together with the game sources (everything except main.cpp), e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\EnvBenchmark.cpp VecEnv.cpp Game.cpp ...
+// Usage: EnvBenchmark [envs] [threads] [steps]
+// Without an env count (or with 0) it runs 1, threads, 4x threads, 16x threads and 64x threads envs.
+
+#include "VecEnv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+struct BenchmarkResult {
+    double stepsPerSecond;
+    long long episodes;
+    double rewardPerStep;
+};
+
+// Step envCount environments with random actions for a number of steps
+static BenchmarkResult measure(int envCount, int threads, int steps) {
+    VecEnv env(envCount, threads);
+    std::vector<std::uint8_t> observations(envCount * OBSERVATION_SIZE);
+    std::vector<int> actions(envCount);
+    std::vector<float> rewards(envCount);
+    std::vector<std::uint8_t> dones(envCount);
+
+    env.reset(1, observations.data());
+
+    std::uint32_t rng = 12345;
+    long long episodes = 0;
+    double totalReward = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; ++step) {
+        for (auto& action : actions) {
+            rng = rng * 1664525u + 1013904223u;
+            action = static_cast<int>((rng >> 16) % ACTION_COUNT);
+        }
+        env.step(actions.data(), observations.data(), rewards.data(), dones.data());
+        for (int i = 0; i < envCount; ++i) {
+            episodes += dones[i];
+            totalReward += rewards[i];
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double envSteps = static_cast<double>(envCount) * steps;
+    return BenchmarkResult{ envSteps / seconds, episodes, totalReward / envSteps };
+}
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+    int steps = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    std::vector<int> envCounts;
+    if (argc > 1 && std::atoi(argv[1]) > 0) {
+        envCounts.push_back(std::atoi(argv[1]));
+    }
+    else {
+        envCounts = { 1, threads, threads * 4, threads * 16, threads * 64 };
+        envCounts.erase(std::unique(envCounts.begin(), envCounts.end()), envCounts.end());
+    }
+
+    std::cout << "Threads: " << threads << ", steps: " << steps << " per env" << std::endl;
+    std::cout << std::setw(8) << "Envs" << std::setw(14) << "Env steps/s" << std::setw(12) << "Episodes" << std::setw(14) << "Reward/step" << std::endl;
+    for (int envCount : envCounts) {
+        BenchmarkResult result = measure(envCount, threads, steps);
+        std::cout << std::setw(8) << envCount << std::setw(14) << std::fixed << std::setprecision(0) << result.stepsPerSecond
+            << std::setw(12) << result.episodes << std::setw(14) << std::setprecision(4) << result.rewardPerStep << std::endl;
+    }
+
+    return 0;
+}
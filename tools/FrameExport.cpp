@@ -0,0 +1,254 @@
+// Exports a game as an animated GIF or a numbered series of PPM images, either from a session
+// recording (GameObject2 --record) or from a headless autopilot game replayed from its seed.
+// Frames are collected in batches and each batch is encoded on all cores.
+// Build from the repository root together with the game sources (everything except main.cpp), e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\FrameExport.cpp GifEncoder.cpp FrameImage.cpp RecordingReader.cpp Game.cpp ...
+// Usage: FrameExport <output.gif | output directory> [--recording <file>] [--seed <n>] [--ticks <n>]
+//                    [--every <n>] [--fps <n>] [--ppm]
+
+#include "AnsiEncoder.h"
+#include "FrameImage.h"
+#include "Game.h"
+#include "GifEncoder.h"
+#include "RecordingReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Frames held in memory at once
+static const std::size_t BATCH_SIZE = 256;
+
+// Simulated time of one game tick
+static const int TICK_MILLISECONDS = 50;
+
+// Longest delay a GIF frame can have
+static const int MAX_DELAY = 65535;
+
+// Collects frames and writes them out a batch at a time
+class Exporter {
+private:
+    std::string outputPath;
+    bool ppm;
+    std::ofstream gif;
+
+    std::vector<Frame> batch;
+    std::vector<int> delays;        // Hundredths of a second each frame stays up
+    Frame previous;                 // Last frame of the previous batch
+    bool havePrevious;
+
+    // Encoded frame waiting for its delay to be known; unchanged frames add to it
+    GifFrame pending;
+    int pendingDelay;
+    bool havePending;
+
+    std::size_t framesWritten;
+    std::size_t bytesWritten;
+
+    void writePending() {
+        if (havePending) {
+            writeGifFrame(gif, pending, std::min(pendingDelay, MAX_DELAY));
+            bytesWritten += pending.data.size();
+            havePending = false;
+        }
+    }
+
+    // Encode the batch on every core, then write it in order
+    void flushBatch() {
+        if (batch.empty()) {
+            return;
+        }
+
+        std::vector<GifFrame> encoded(ppm ? 0 : batch.size());
+        std::size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        std::size_t slice = (batch.size() + workers - 1) / workers;
+        std::vector<std::future<void>> jobs;
+        for (std::size_t first = 0; first < batch.size(); first += slice) {
+            std::size_t last = std::min(first + slice, batch.size());
+            jobs.push_back(std::async(std::launch::async, [this, &encoded, first, last] {
+                for (std::size_t i = first; i < last; ++i) {
+                    if (ppm) {
+                        char name[32];
+                        std::snprintf(name, sizeof(name), "/frame_%06zu.ppm", framesWritten + i);
+                        std::ofstream out(outputPath + name, std::ios::binary);
+                        writePpm(batch[i], out);
+                    }
+                    else {
+                        const Frame* before = i > 0 ? &batch[i - 1] : (havePrevious ? &previous : nullptr);
+                        encoded[i] = encodeGifFrame(before, batch[i]);
+                    }
+                }
+            }));
+        }
+        for (auto& job : jobs) {
+            job.get();
+        }
+
+        for (std::size_t i = 0; i < encoded.size(); ++i) {
+            if (encoded[i].width == 0 && havePending) {
+                pendingDelay += delays[i];
+                continue;
+            }
+            writePending();
+            pending = std::move(encoded[i]);
+            pendingDelay = delays[i];
+            havePending = true;
+        }
+
+        framesWritten += batch.size();
+        previous = batch.back();
+        havePrevious = true;
+        batch.clear();
+        delays.clear();
+    }
+
+public:
+    Exporter(const std::string& outputPath, bool ppm)
+        : outputPath(outputPath), ppm(ppm), havePrevious(false), pending(), pendingDelay(0), havePending(false),
+        framesWritten(0), bytesWritten(0) {
+        if (!ppm) {
+            gif.open(outputPath, std::ios::binary);
+            writeGifHeader(gif);
+        }
+        batch.reserve(BATCH_SIZE);
+    }
+
+    bool isOpen() const {
+        return ppm || gif.is_open();
+    }
+
+    void add(const Frame& frame, int delayCentiseconds) {
+        batch.push_back(frame);
+        delays.push_back(std::max(delayCentiseconds, 1));
+        if (batch.size() == BATCH_SIZE) {
+            flushBatch();
+        }
+    }
+
+    void finish() {
+        flushBatch();
+        if (!ppm) {
+            writePending();
+            writeGifTrailer(gif);
+        }
+    }
+
+    std::size_t getFramesWritten() const { return framesWritten; }
+    std::size_t getBytesWritten() const { return bytesWritten; }
+};
+
+// Replay a recording, taking the screen at most fps times a second
+static bool exportRecording(const std::string& path, int fps, Exporter& exporter) {
+    RecordingReader reader(path);
+    if (!reader.isValid()) {
+        std::cerr << "Not a session recording: " << path << std::endl;
+        return false;
+    }
+
+    Frame screen;
+    TerminalState terminal;
+    RecordingEntry entry;
+    std::uint32_t interval = 1000 / std::max(fps, 1);
+    std::uint32_t lastTime = 0;
+    bool haveFrame = false;
+    while (reader.next(entry)) {
+        // The screen up to this record is final; emit it if enough time has passed
+        if (haveFrame && entry.timeMs - lastTime >= interval) {
+            exporter.add(screen, static_cast<int>((entry.timeMs - lastTime) / 10));
+            lastTime = entry.timeMs;
+        }
+        if (!haveFrame) {
+            lastTime = entry.timeMs;
+            haveFrame = true;
+        }
+        decodeAnsi(entry.data, screen, terminal);
+    }
+    if (haveFrame) {
+        exporter.add(screen, 200);
+    }
+    return true;
+}
+
+// Play a headless autopilot game from a seed, taking every nth tick
+static void exportGame(std::uint64_t seed, int ticks, int every, Exporter& exporter) {
+    GameOptions options;
+    options.headless = true;
+    options.autopilot = true;
+    options.seed = seed;
+    Game game(options);
+
+    int delay = TICK_MILLISECONDS * every / 10;
+    for (int tick = 0; tick < ticks && game.step(ACTION_NONE); ++tick) {
+        if (tick % every == 0) {
+            exporter.add(game.drawFrame(), delay);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: FrameExport <output.gif | output directory> [--recording <file>] [--seed <n>] "
+            "[--ticks <n>] [--every <n>] [--fps <n>] [--ppm]" << std::endl;
+        return 1;
+    }
+
+    std::string recordingPath;
+    std::uint64_t seed = 1;
+    int ticks = 12000;
+    int every = 2;
+    int fps = 10;
+    bool ppm = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--recording") == 0 && i + 1 < argc) {
+            recordingPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            every = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fps = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ppm") == 0) {
+            ppm = true;
+        }
+    }
+
+    Exporter exporter(argv[1], ppm);
+    if (!exporter.isOpen()) {
+        std::cerr << "Cannot write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!recordingPath.empty()) {
+        if (!exportRecording(recordingPath, fps, exporter)) {
+            return 1;
+        }
+    }
+    else {
+        exportGame(seed, ticks, every, exporter);
+    }
+    exporter.finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Frames:  " << exporter.getFramesWritten() << "\n";
+    if (!ppm) {
+        std::cout << "Image data: " << exporter.getBytesWritten() << " bytes\n";
+    }
+    std::cout << "Time:    " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,243 @@
+// Checks the GIF encoder against a decoder of its own: frames of a headless autopilot game are
+// written as an animated GIF, which is then read back - header, palette, extensions and LZW image
+// data - and drawn frame over frame. After every frame the picture must be exactly what
+// rasterising the game's frame gives.
+// Build from the repository root together with the game sources (everything except main.cpp), e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\GifCheck.cpp GifEncoder.cpp FrameImage.cpp Game.cpp ...
+// Usage: GifCheck [ticks] [seed]
+// Exits with 1 if any check fails.
+
+#include "FrameImage.h"
+#include "Game.h"
+#include "GifEncoder.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// FNV-1a over a picture, so expected pictures need not all be kept
+static std::uint64_t hashPixels(const std::vector<std::uint8_t>& pixels) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::uint8_t pixel : pixels) {
+        hash = (hash ^ pixel) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Sequential reader over the encoded file; reads past the end give zeros and set failed
+class GifReader {
+private:
+    const std::string& data;
+    std::size_t position;
+
+public:
+    bool failed;
+
+    explicit GifReader(const std::string& data) : data(data), position(0), failed(false) {}
+
+    int byte() {
+        if (position >= data.size()) {
+            failed = true;
+            return 0;
+        }
+        return static_cast<unsigned char>(data[position++]);
+    }
+
+    int word() {
+        int low = byte();
+        return low | (byte() << 8);
+    }
+
+    // Concatenated sub-blocks up to the zero-length terminator
+    std::string subBlocks() {
+        std::string result;
+        for (int size = byte(); size != 0 && !failed; size = byte()) {
+            for (int i = 0; i < size; ++i) {
+                result += static_cast<char>(byte());
+            }
+        }
+        return result;
+    }
+
+    bool atEnd() const {
+        return position >= data.size();
+    }
+};
+
+// Standard GIF LZW decoding of one image's data into pixels; false if the codes don't make sense
+static bool decompressPixels(int minCodeSize, const std::string& data, std::vector<std::uint8_t>& pixels) {
+    const int clearCode = 1 << minCodeSize;
+    const int endCode = clearCode + 1;
+
+    // Each entry is its prefix entry plus one pixel; first is the pixel the string starts with
+    std::vector<int> prefix(4096, -1);
+    std::vector<std::uint8_t> suffix(4096, 0);
+    std::vector<std::uint8_t> first(4096, 0);
+    for (int i = 0; i < clearCode; ++i) {
+        suffix[i] = static_cast<std::uint8_t>(i);
+        first[i] = static_cast<std::uint8_t>(i);
+    }
+
+    int codeSize = minCodeSize + 1;
+    int nextCode = endCode + 1;
+    int previous = -1;
+    std::uint32_t bits = 0;
+    int bitCount = 0;
+    std::size_t position = 0;
+    std::vector<std::uint8_t> string;
+
+    pixels.clear();
+    while (true) {
+        while (bitCount < codeSize) {
+            if (position >= data.size()) {
+                return false;
+            }
+            bits |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[position++])) << bitCount;
+            bitCount += 8;
+        }
+        int code = static_cast<int>(bits & ((1u << codeSize) - 1));
+        bits >>= codeSize;
+        bitCount -= codeSize;
+
+        if (code == clearCode) {
+            codeSize = minCodeSize + 1;
+            nextCode = endCode + 1;
+            previous = -1;
+            continue;
+        }
+        if (code == endCode) {
+            return true;
+        }
+        if (code > nextCode || (previous < 0 && code >= clearCode)) {
+            return false;
+        }
+
+        // A code not in the table yet can only be the previous string plus its own first pixel
+        if (previous >= 0 && nextCode < 4096) {
+            prefix[nextCode] = previous;
+            suffix[nextCode] = first[code == nextCode ? previous : code];
+            first[nextCode] = first[previous];
+            ++nextCode;
+            if (nextCode == (1 << codeSize) && codeSize < 12) {
+                ++codeSize;
+            }
+        }
+
+        string.clear();
+        for (int entry = code; entry >= 0; entry = prefix[entry]) {
+            string.push_back(suffix[entry]);
+        }
+        pixels.insert(pixels.end(), string.rbegin(), string.rend());
+        previous = code;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 1500;
+    std::uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 7;
+
+    GameOptions options;
+    options.headless = true;
+    options.autopilot = true;
+    options.seed = seed;
+    Game game(options);
+
+    // Encode every tick's frame, remembering what the picture should look like after each one
+    std::ostringstream stream;
+    writeGifHeader(stream);
+    std::vector<std::uint64_t> expected;
+    std::vector<std::uint8_t> pixels;
+    Frame previous;
+    bool havePrevious = false;
+    for (int tick = 0; tick < ticks && game.step(ACTION_NONE); ++tick) {
+        const Frame& frame = game.drawFrame();
+        GifFrame encoded = encodeGifFrame(havePrevious ? &previous : nullptr, frame);
+        previous = frame;
+        havePrevious = true;
+        if (encoded.width == 0) {
+            continue;
+        }
+        writeGifFrame(stream, encoded, 5);
+        rasterizeCells(frame, 0, 0, POLE_COLS - 1, POLE_ROWS - 1, pixels);
+        expected.push_back(hashPixels(pixels));
+    }
+    writeGifTrailer(stream);
+    std::string gif = stream.str();
+
+    // Header and palette
+    GifReader reader(gif);
+    char signature[6];
+    for (char& c : signature) {
+        c = static_cast<char>(reader.byte());
+    }
+    check(std::memcmp(signature, "GIF89a", 6) == 0, "signature is not GIF89a");
+    check(reader.word() == IMAGE_WIDTH && reader.word() == IMAGE_HEIGHT, "screen size differs");
+    int flags = reader.byte();
+    check((flags & 0x80) != 0 && (2 << (flags & 0x07)) == PALETTE_SIZE, "no 16-colour global palette");
+    reader.byte();
+    reader.byte();
+    bool samePalette = true;
+    for (int i = 0; i < PALETTE_SIZE; ++i) {
+        for (int channel = 0; channel < 3; ++channel) {
+            samePalette = samePalette && reader.byte() == CONSOLE_PALETTE[i][channel];
+        }
+    }
+    check(samePalette, "palette differs from the console palette");
+
+    // Blocks until the trailer, drawing each image over the picture so far
+    std::vector<std::uint8_t> canvas(static_cast<std::size_t>(IMAGE_WIDTH) * IMAGE_HEIGHT, 0);
+    std::size_t images = 0;
+    bool trailer = false;
+    while (!reader.failed && !trailer && failures == 0) {
+        int introducer = reader.byte();
+        if (introducer == 0x21) {
+            reader.byte();
+            reader.subBlocks();
+        }
+        else if (introducer == 0x2C) {
+            int left = reader.word();
+            int top = reader.word();
+            int width = reader.word();
+            int height = reader.word();
+            check(reader.byte() == 0, "image " + std::to_string(images) + " has a local palette or is interlaced");
+            check(left + width <= IMAGE_WIDTH && top + height <= IMAGE_HEIGHT, "image " + std::to_string(images) + " is off the screen");
+            int minCodeSize = reader.byte();
+            std::string data = reader.subBlocks();
+            if (!decompressPixels(minCodeSize, data, pixels) || pixels.size() != static_cast<std::size_t>(width) * height) {
+                check(false, "image " + std::to_string(images) + " does not decode to its rectangle");
+                break;
+            }
+            for (int y = 0; y < height; ++y) {
+                std::memcpy(&canvas[static_cast<std::size_t>(top + y) * IMAGE_WIDTH + left], &pixels[static_cast<std::size_t>(y) * width], width);
+            }
+            check(images < expected.size() && hashPixels(canvas) == expected[images],
+                "picture after image " + std::to_string(images) + " differs from the frame");
+            ++images;
+        }
+        else if (introducer == 0x3B) {
+            trailer = true;
+        }
+        else {
+            check(false, "unknown block " + std::to_string(introducer));
+        }
+    }
+    check(trailer && reader.atEnd(), "file does not end with the trailer");
+    check(images == expected.size(), "read " + std::to_string(images) + " of " + std::to_string(expected.size()) + " images");
+
+    std::cout << images << " images, " << gif.size() << " bytes" << std::endl;
+    std::cout << (failures == 0 ? "All GIF checks passed" : "GIF checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
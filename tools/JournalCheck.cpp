@@ -0,0 +1,134 @@
+// Checks that events written with EventJournal come back unchanged through JournalReader: several
+// full blocks and a partial one, levels past the 16-bit limit, a journal reopened on a new file,
+// and a file cut short in the middle of a block, of which only the whole blocks are read.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\JournalCheck.cpp EventJournal.cpp JournalReader.cpp
+// Usage: JournalCheck [directory]   (temporary files go there, the system temp directory by default)
+// Exits with 1 if any check fails.
+
+#include "EventJournal.h"
+#include "JournalReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// One event as passed to EventJournal::record
+struct ExpectedEvent {
+    EventKind kind;
+    std::uint32_t tick;
+    int level;
+    int subject;
+    int x;
+    int y;
+    int value;
+};
+
+// Events with every field varying, a few of them on levels too high for the level column
+static std::vector<ExpectedEvent> makeEvents(int count, std::uint32_t seed) {
+    std::vector<ExpectedEvent> events;
+    events.reserve(count);
+    std::uint32_t state = seed;
+    for (int i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        ExpectedEvent event;
+        event.kind = static_cast<EventKind>(state % EVENT_KIND_COUNT);
+        event.tick = static_cast<std::uint32_t>(i) * 3 + (state >> 30);
+        event.level = (i % 1000 == 999) ? JOURNAL_MAX_LEVEL + 10 + i : 1 + static_cast<int>((state >> 8) % 40);
+        event.subject = static_cast<int>((state >> 12) % 5);
+        event.x = static_cast<int>((state >> 4) % 160) - 20;
+        event.y = static_cast<int>((state >> 16) % 60) - 5;
+        event.value = static_cast<int>(state >> 1) - 0x20000000;
+        events.push_back(event);
+    }
+    return events;
+}
+
+// Read a journal back and compare it with the events written; returns the events read
+static std::size_t checkRead(const std::string& path, std::uint64_t seed, const std::vector<ExpectedEvent>& events,
+    const std::string& name) {
+    JournalReader reader(path);
+    check(reader.isValid(), name + ": file is not a valid journal");
+    if (!reader.isValid()) {
+        return 0;
+    }
+    check(reader.getSeed() == seed, name + ": seed differs");
+
+    std::size_t read = 0;
+    std::size_t mismatches = 0;
+    JournalBlock block;
+    while (reader.next(block)) {
+        for (std::size_t i = 0; i < block.count; ++i, ++read) {
+            if (read >= events.size()) {
+                ++mismatches;
+                continue;
+            }
+            const ExpectedEvent& expected = events[read];
+            if (block.kinds[i] != expected.kind || block.ticks[i] != expected.tick ||
+                block.levels[i] != std::clamp(expected.level, 0, JOURNAL_MAX_LEVEL) ||
+                block.subjects[i] != expected.subject || block.xs[i] != expected.x || block.ys[i] != expected.y ||
+                block.values[i] != expected.value) {
+                ++mismatches;
+            }
+        }
+    }
+    check(mismatches == 0, name + ": " + std::to_string(mismatches) + " events differ from what was written");
+    return read;
+}
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path directory = argc > 1 ? std::filesystem::path(argv[1]) :
+        std::filesystem::temp_directory_path() / "JournalCheck";
+    std::string first = (directory / "first.journal").string();
+    std::string second = (directory / "second.journal").string();
+
+    // Three full blocks and a partial one, enough to keep the writer thread queueing
+    std::vector<ExpectedEvent> events = makeEvents(JOURNAL_BLOCK_EVENTS * 3 + 123, 7);
+    std::vector<ExpectedEvent> fewer = makeEvents(500, 8);
+
+    // Reopening finishes the first file before starting the second
+    std::filesystem::create_directories(directory);
+    {
+        EventJournal journal;
+        check(journal.open(first, 1234), "could not open " + first);
+        for (const ExpectedEvent& event : events) {
+            journal.record(event.kind, event.tick, event.level, event.subject, event.x, event.y, event.value);
+        }
+        check(journal.open(second, 5678), "could not open " + second);
+        for (const ExpectedEvent& event : fewer) {
+            journal.record(event.kind, event.tick, event.level, event.subject, event.x, event.y, event.value);
+        }
+    }
+
+    std::size_t read = checkRead(first, 1234, events, "first journal");
+    check(read == events.size(), "first journal: read " + std::to_string(read) + " of " + std::to_string(events.size()) + " events");
+    read = checkRead(second, 5678, fewer, "second journal");
+    check(read == fewer.size(), "second journal: read " + std::to_string(read) + " of " + std::to_string(fewer.size()) + " events");
+
+    // A crash in the middle of writing the last block leaves it short; the whole blocks still read
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(first, error);
+    if (!error) {
+        std::filesystem::resize_file(first, size - 100, error);
+    }
+    read = checkRead(first, 1234, events, "cut journal");
+    check(read == static_cast<std::size_t>(JOURNAL_BLOCK_EVENTS) * 3,
+        "cut journal: read " + std::to_string(read) + " events, expected the three whole blocks");
+
+    std::filesystem::remove_all(directory, error);
+
+    std::cout << (failures == 0 ? "All journal checks passed" : "Journal checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+// Aggregates event journals (GameObject2 --journal <dir>) across any number of runs.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\JournalQuery.cpp JournalReader.cpp
+// Usage: JournalQuery <summary | kills | deaths | accuracy> <journal files or directories...>
+//   summary   events of each kind
+//   kills     kills per enemy type per level
+//   deaths    distribution of how long a life lasts
+//   accuracy  player shots and kills per level
+
+#include "JournalReader.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define JOURNAL_QUERY_SSE2 1
+#endif
+
+static const char* const KIND_NAMES[EVENT_KIND_COUNT] = { "kill", "player hit", "player shot", "enemy shot", "level start", "extra life" };
+static const char* const ENEMY_NAMES[] = { "EnemyType1", "EnemyType2", "EnemyType3", "EnemyType4", "EnemyBoss" };
+static const int ENEMY_TYPES = 5;
+static const int MAX_LEVELS = JOURNAL_MAX_LEVEL + 1;
+
+// Ticks are 50 ms; lives are bucketed by 10 seconds
+static const int TICKS_PER_SECOND = 20;
+static const int LIFE_BUCKET_SECONDS = 10;
+static const int LIFE_BUCKETS = 30;
+
+// Call found(i) for every event of the given kind, 16 kinds compared per instruction
+template <typename Found>
+static void forEachOfKind(const JournalBlock& block, EventKind kind, Found found) {
+    std::size_t i = 0;
+#ifdef JOURNAL_QUERY_SSE2
+    const __m128i wanted = _mm_set1_epi8(static_cast<char>(kind));
+    for (; i + 16 <= block.count; i += 16) {
+        __m128i kinds = _mm_load_si128(reinterpret_cast<const __m128i*>(block.kinds + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(kinds, wanted)));
+        while (mask != 0) {
+            found(i + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < block.count; ++i) {
+        if (block.kinds[i] == kind) {
+            found(i);
+        }
+    }
+}
+
+// Events of every kind at once - one compare and popcount per kind and 16 events
+static void countKinds(const JournalBlock& block, long long counts[EVENT_KIND_COUNT]) {
+    std::size_t i = 0;
+#ifdef JOURNAL_QUERY_SSE2
+    for (; i + 16 <= block.count; i += 16) {
+        __m128i kinds = _mm_load_si128(reinterpret_cast<const __m128i*>(block.kinds + i));
+        for (int kind = 0; kind < EVENT_KIND_COUNT; ++kind) {
+            __m128i match = _mm_cmpeq_epi8(kinds, _mm_set1_epi8(static_cast<char>(kind)));
+            counts[kind] += std::popcount(static_cast<unsigned>(_mm_movemask_epi8(match)));
+        }
+    }
+#endif
+    for (; i < block.count; ++i) {
+        if (block.kinds[i] < EVENT_KIND_COUNT) {
+            ++counts[block.kinds[i]];
+        }
+    }
+}
+
+// Every *.evj under the given files and directories
+static std::vector<std::string> collectJournals(int argc, char* argv[]) {
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; ++i) {
+        std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".evj") {
+                    paths.push_back(entry.path().string());
+                }
+            }
+        }
+        else {
+            paths.push_back(path.string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: JournalQuery <summary | kills | deaths | accuracy> <journal files or directories...>" << std::endl;
+        return 1;
+    }
+    std::string query = argv[1];
+    if (query != "summary" && query != "kills" && query != "deaths" && query != "accuracy") {
+        std::cerr << "Unknown query: " << query << std::endl;
+        return 1;
+    }
+
+    long long kindCounts[EVENT_KIND_COUNT] = {};
+    std::vector<long long> kills(MAX_LEVELS * ENEMY_TYPES, 0);
+    std::vector<long long> shots(MAX_LEVELS, 0);
+    std::vector<long long> lifeBuckets(LIFE_BUCKETS, 0);
+    long long lives = 0;
+    long long lifeTicks = 0;
+    int highestLevel = 0;
+    int runs = 0;
+    int unreadable = 0;
+
+    for (const auto& path : collectJournals(argc, argv)) {
+        JournalReader reader(path);
+        if (!reader.isValid()) {
+            ++unreadable;
+            continue;
+        }
+        ++runs;
+
+        // A life starts with the run and after every hit
+        std::uint32_t lifeStart = 0;
+        JournalBlock block;
+        while (reader.next(block)) {
+            if (query == "summary") {
+                countKinds(block, kindCounts);
+            }
+            else if (query == "kills" || query == "accuracy") {
+                forEachOfKind(block, EVENT_KILL, [&](std::size_t i) {
+                    int level = block.levels[i];
+                    ++kills[level * ENEMY_TYPES + std::min<int>(block.subjects[i], ENEMY_TYPES - 1)];
+                    highestLevel = std::max(highestLevel, level);
+                    });
+                if (query == "accuracy") {
+                    forEachOfKind(block, EVENT_PLAYER_SHOT, [&](std::size_t i) {
+                        ++shots[block.levels[i]];
+                        highestLevel = std::max<int>(highestLevel, block.levels[i]);
+                        });
+                }
+            }
+            else {
+                forEachOfKind(block, EVENT_PLAYER_HIT, [&](std::size_t i) {
+                    std::uint32_t ticks = block.ticks[i] - lifeStart;
+                    lifeStart = block.ticks[i];
+                    ++lifeBuckets[std::min(LIFE_BUCKETS - 1, static_cast<int>(ticks / (TICKS_PER_SECOND * LIFE_BUCKET_SECONDS)))];
+                    ++lives;
+                    lifeTicks += ticks;
+                    });
+            }
+        }
+    }
+
+    std::cout << "Runs: " << runs;
+    if (unreadable > 0) {
+        std::cout << " (" << unreadable << " unreadable)";
+    }
+    std::cout << "\n\n";
+
+    if (query == "summary") {
+        for (int kind = 0; kind < EVENT_KIND_COUNT; ++kind) {
+            std::cout << std::left << std::setw(14) << KIND_NAMES[kind] << kindCounts[kind] << "\n";
+        }
+    }
+    else if (query == "kills") {
+        std::cout << std::left << std::setw(8) << "Level";
+        for (const char* name : ENEMY_NAMES) {
+            std::cout << std::setw(12) << name;
+        }
+        std::cout << "\n";
+        for (int level = 1; level <= highestLevel; ++level) {
+            std::cout << std::setw(8) << level;
+            for (int type = 0; type < ENEMY_TYPES; ++type) {
+                std::cout << std::setw(12) << kills[level * ENEMY_TYPES + type];
+            }
+            std::cout << "\n";
+        }
+    }
+    else if (query == "accuracy") {
+        std::cout << std::left << std::setw(8) << "Level" << std::setw(12) << "Shots" << std::setw(12) << "Kills" << "Hit rate\n";
+        for (int level = 1; level <= highestLevel; ++level) {
+            long long levelKills = 0;
+            for (int type = 0; type < ENEMY_TYPES; ++type) {
+                levelKills += kills[level * ENEMY_TYPES + type];
+            }
+            std::cout << std::setw(8) << level << std::setw(12) << shots[level] << std::setw(12) << levelKills
+                << (shots[level] > 0 ? 100.0 * levelKills / shots[level] : 0.0) << "%\n";
+        }
+    }
+    else {
+        std::cout << "Lives lost: " << lives << ", average length "
+            << (lives > 0 ? static_cast<double>(lifeTicks) / lives / TICKS_PER_SECOND : 0.0) << " s\n\n";
+        long long largest = std::max<long long>(1, *std::max_element(lifeBuckets.begin(), lifeBuckets.end()));
+        for (int bucket = 0; bucket < LIFE_BUCKETS; ++bucket) {
+            std::string label = std::to_string(bucket * LIFE_BUCKET_SECONDS) + (bucket == LIFE_BUCKETS - 1 ? "+ s" : "-" +
+                std::to_string((bucket + 1) * LIFE_BUCKET_SECONDS) + " s");
+            std::cout << std::right << std::setw(10) << label << std::setw(8) << lifeBuckets[bucket] << "  "
+                << std::string(static_cast<std::size_t>(40 * lifeBuckets[bucket] / largest), '#') << "\n";
+        }
+    }
+    return 0;
+}
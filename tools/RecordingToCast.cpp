@@ -0,0 +1,36 @@
+// Converts a session recording (GameObject2 --record) to an asciicast v2 file for asciinema.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\RecordingToCast.cpp RecordingReader.cpp
+// Usage: RecordingToCast <recording> <output.cast> [start seconds]
+
+#include "RecordingReader.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: RecordingToCast <recording> <output.cast> [start seconds]" << std::endl;
+        return 1;
+    }
+
+    RecordingReader reader(argv[1]);
+    if (!reader.isValid()) {
+        std::cerr << "Not a session recording: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Start at the keyframe before the requested time, so the first screen is complete
+    if (argc > 3) {
+        std::uint32_t startMs = static_cast<std::uint32_t>(std::atof(argv[3]) * 1000);
+        reader.seek(startMs);
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!exportAsciicast(reader, out)) {
+        std::cerr << "Cannot write " << argv[2] << std::endl;
+        return 1;
+    }
+    return 0;
+}
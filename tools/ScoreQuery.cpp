@@ -0,0 +1,91 @@
+// Queries the high-score table the game keeps with --scores (highscores.dat by default).
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\ScoreQuery.cpp ScoreTable.cpp
+// Usage: ScoreQuery <file> top [count]
+//        ScoreQuery <file> history <player> [count]
+//        ScoreQuery <file> fill <runs> [players]   (appends random runs, for timing queries on a large table)
+
+#include "ScoreTable.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Print runs one per line
+static void printRecords(const std::vector<ScoreRecord>& records) {
+    int position = 1;
+    for (const ScoreRecord& record : records) {
+        std::time_t time = static_cast<std::time_t>(record.time);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M", std::localtime(&time));
+        std::cout << std::setw(4) << position++ << "  " << std::left << std::setw(16) << scorePlayerName(record) << std::right
+                  << std::setw(8) << record.score << "  level " << record.level << "  " << record.ticks / 20 << "s  "
+                  << (record.won ? "won " : "    ") << "  seed " << record.seed << "  " << date << '\n';
+    }
+}
+
+static double microsecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: ScoreQuery <file> top [count] | history <player> [count] | fill <runs> [players]" << std::endl;
+        return 1;
+    }
+
+    auto openStart = std::chrono::steady_clock::now();
+    ScoreTable table(argv[1]);
+    if (!table.isOpen()) {
+        std::cerr << "Could not open " << argv[1] << std::endl;
+        return 1;
+    }
+    double openTime = microsecondsSince(openStart);
+
+    std::string command = argv[2];
+    if (command == "top") {
+        int count = argc > 3 ? std::atoi(argv[3]) : 10;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ScoreRecord> records = table.top(count);
+        double queryTime = microsecondsSince(start);
+        printRecords(records);
+        std::cout << table.size() << " runs, opened in " << openTime << " us, queried in " << queryTime << " us" << std::endl;
+    }
+    else if (command == "history" && argc > 3) {
+        int count = argc > 4 ? std::atoi(argv[4]) : 10;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ScoreRecord> records = table.history(argv[3], count);
+        ScoreRecord best;
+        bool hasBest = table.best(argv[3], best);
+        double queryTime = microsecondsSince(start);
+        printRecords(records);
+        if (hasBest) {
+            std::cout << "Best: " << best.score << " on level " << best.level << '\n';
+        }
+        std::cout << table.size() << " runs, opened in " << openTime << " us, queried in " << queryTime << " us" << std::endl;
+    }
+    else if (command == "fill" && argc > 3) {
+        int runs = std::atoi(argv[3]);
+        int players = argc > 4 ? std::atoi(argv[4]) : 100;
+        std::mt19937_64 random(std::random_device{}());
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < runs; ++i) {
+            int level = static_cast<int>(random() % 3) + 1;
+            table.append("bot" + std::to_string(random() % players), static_cast<int>(random() % 100000), level,
+                random(), static_cast<std::uint32_t>(random() % 20000), level == 3 && random() % 2 == 0);
+        }
+        double fillTime = microsecondsSince(start);
+        std::cout << "Appended " << runs << " runs in " << fillTime / 1000.0 << " ms, table has " << table.size() << std::endl;
+    }
+    else {
+        std::cerr << "Unknown command " << command << std::endl;
+        return 1;
+    }
+    return 0;
+}
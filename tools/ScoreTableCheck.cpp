@@ -0,0 +1,172 @@
+// Checks that a ScoreTable file survives the ways a writer can die part way: an index left stale,
+// a record torn in the middle of being written, a record written but never counted, and a file
+// whose creation never finished. Each is made by editing a closed table file directly, and the
+// table opened on it afterwards must answer queries as if only the complete runs were there.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\ScoreTableCheck.cpp ScoreTable.cpp
+// Usage: ScoreTableCheck [file]   (a temporary file, removed afterwards; the system temp directory by default)
+// Exits with 1 if any check fails.
+
+#include "ScoreTable.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Start of ScoreTable's file header: magic, version, capacity, record count, indexed count,
+// then the top list. The records follow the whole header, which is sized from the file -
+// a new table has room for 1024 records.
+static const std::streamoff INDEXED_COUNT_OFFSET = 20;
+static const std::streamoff TOP_COUNT_OFFSET = 24;
+static const std::uint32_t NEW_TABLE_CAPACITY = 1024;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// A run the table should know about
+struct ExpectedRun {
+    std::string player;
+    int score;
+};
+
+// Where the records start in a table file that has not grown
+static std::streamoff recordsOffset(const std::string& path) {
+    return static_cast<std::streamoff>(std::filesystem::file_size(path) - NEW_TABLE_CAPACITY * sizeof(ScoreRecord));
+}
+
+static void poke(const std::string& path, std::streamoff offset, const void* data, std::size_t size) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset);
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+// The index claims to cover nothing, as if its writer died half way through updating it
+static void markIndexStale(const std::string& path) {
+    std::uint32_t zero = 0;
+    poke(path, INDEXED_COUNT_OFFSET, &zero, sizeof(zero));
+    poke(path, TOP_COUNT_OFFSET, &zero, sizeof(zero));
+}
+
+// Compare the table's top list, and every player's best run and history length, with the runs
+static void checkTable(const ScoreTable& table, std::vector<ExpectedRun> runs, const std::string& name) {
+    // Later runs rank below earlier ones with the same score
+    std::vector<ExpectedRun> ranked = runs;
+    std::stable_sort(ranked.begin(), ranked.end(), [](const ExpectedRun& a, const ExpectedRun& b) { return a.score > b.score; });
+
+    std::vector<ScoreRecord> top = table.top(20);
+    check(top.size() == std::min<std::size_t>(ranked.size(), 20), name + ": top list has " + std::to_string(top.size()) + " runs");
+    for (std::size_t i = 0; i < top.size() && i < ranked.size(); ++i) {
+        if (scorePlayerName(top[i]) != ranked[i].player || top[i].score != ranked[i].score) {
+            check(false, name + ": top list differs at rank " + std::to_string(i + 1));
+            break;
+        }
+    }
+
+    for (const char* player : { "alice", "bob", "carol" }) {
+        int runCount = 0;
+        int bestScore = -1;
+        for (const ExpectedRun& run : runs) {
+            if (run.player == player) {
+                ++runCount;
+                bestScore = std::max(bestScore, run.score);
+            }
+        }
+        ScoreRecord best;
+        bool found = table.best(player, best);
+        check(found == (runCount > 0) && (!found || best.score == bestScore), name + ": best run of " + player + " differs");
+        check(static_cast<int>(table.history(player, 1000).size()) == runCount, name + ": history of " + player + " differs");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : (std::filesystem::temp_directory_path() / "ScoreTableCheck.dat").string();
+    std::filesystem::remove(path);
+
+    static const char* PLAYERS[] = { "alice", "bob", "carol" };
+    std::vector<ExpectedRun> runs;
+    {
+        ScoreTable table(path);
+        check(table.isOpen(), "could not create " + path);
+        for (int i = 0; i < 60; ++i) {
+            ExpectedRun run = { PLAYERS[i % 3], (i * 37) % 500 };
+            table.append(run.player, run.score, 1 + i % 3, static_cast<std::uint64_t>(i), 100u * i, i % 7 == 0);
+            runs.push_back(run);
+        }
+        checkTable(table, runs, "fresh table");
+    }
+
+    // A stale index is rebuilt from the records on the next open
+    markIndexStale(path);
+    {
+        ScoreTable table(path);
+        check(table.size() == runs.size(), "stale index: record count changed");
+        checkTable(table, runs, "stale index");
+    }
+
+    // A record torn by a crash fails its checksum and is left out of the rebuilt index
+    {
+        ScoreRecord torn;
+        std::memset(&torn, 0, sizeof(torn));
+        std::streamoff last = recordsOffset(path) + static_cast<std::streamoff>((runs.size() - 1) * sizeof(ScoreRecord));
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(last);
+        in.read(reinterpret_cast<char*>(&torn), sizeof(torn));
+        in.close();
+        torn.score = 100000;
+        poke(path, last, &torn, sizeof(torn));
+        markIndexStale(path);
+    }
+    runs.pop_back();
+    {
+        ScoreTable table(path);
+        checkTable(table, runs, "torn record");
+
+        // Appending afterwards chains the player's runs past the torn one
+        ExpectedRun run = { "carol", 450 };
+        table.append(run.player, run.score, 2, 99, 5000, false);
+        runs.push_back(run);
+        checkTable(table, runs, "append after torn record");
+    }
+
+    // A record written but never counted is not part of the table, and the next run replaces it
+    {
+        std::vector<char> garbage(sizeof(ScoreRecord), 'x');
+        std::streamoff next = recordsOffset(path) + static_cast<std::streamoff>((runs.size() + 1) * sizeof(ScoreRecord));
+        poke(path, next, garbage.data(), garbage.size());
+    }
+    {
+        ScoreTable table(path);
+        check(table.size() == runs.size() + 1, "uncounted record: record count changed");
+        checkTable(table, runs, "uncounted record");
+        ExpectedRun run = { "bob", 499 };
+        table.append(run.player, run.score, 3, 100, 6000, true);
+        runs.push_back(run);
+        checkTable(table, runs, "append over uncounted record");
+    }
+
+    // A file cut short before its header was complete is created again
+    std::filesystem::resize_file(path, 10);
+    {
+        ScoreTable table(path);
+        check(table.isOpen(), "cut file: not opened");
+        check(table.size() == 0, "cut file: not created again");
+        table.append("alice", 10, 1, 1, 100, false);
+        checkTable(table, { { "alice", 10 } }, "cut file");
+    }
+
+    std::filesystem::remove(path);
+
+    std::cout << (failures == 0 ? "All score table checks passed" : "Score table checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Checks that rollback snapshots put a game back exactly where it was: a headless game is run
+// once straight through, then again rolling back a few ticks every so often and resimulating
+// them, and both runs must produce the same snapshot checksum after every tick.
+// Build from the repository root together with the game sources (everything except main.cpp), e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\SnapshotCheck.cpp GameSnapshot.cpp Game.cpp ...
+// Usage: SnapshotCheck [ticks] [seed]
+// Exits with 1 if any check fails.
+
+#include "Game.h"
+#include "GameSnapshot.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Ticks rolled back at a time, and how often
+static const int ROLLBACK_TICKS = 8;
+static const int ROLLBACK_EVERY = 5;
+static const int HISTORY = 16;
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Run one game straight and one with rollbacks on the same inputs and compare them tick by tick
+static void checkRollback(bool twoPlayers, int ticks, std::uint64_t seed) {
+    GameOptions options;
+    options.headless = true;
+    options.seed = seed;
+    options.twoPlayers = twoPlayers;
+    std::string name = twoPlayers ? "two players" : "one player";
+
+    // Random inputs for both ships, the same for every run
+    std::mt19937 random(static_cast<std::mt19937::result_type>(seed));
+    std::vector<Action> actions(ticks);
+    std::vector<Action> partnerActions(ticks);
+    for (int i = 0; i < ticks; ++i) {
+        actions[i] = static_cast<Action>(random() % ACTION_COUNT);
+        partnerActions[i] = static_cast<Action>(random() % ACTION_COUNT);
+    }
+
+    // Reference run
+    Game reference(options);
+    GameSnapshot snapshot;
+    reference.prepareSnapshot(snapshot);
+    std::vector<std::uint32_t> expected;
+    for (int tick = 0; tick < ticks && reference.isRunning(); ++tick) {
+        reference.step(actions[tick], partnerActions[tick]);
+        reference.saveSnapshot(snapshot);
+        expected.push_back(snapshot.checksum());
+    }
+
+    // Saving straight after a restore gives back the same state
+    GameSnapshot again;
+    reference.prepareSnapshot(again);
+    reference.restoreSnapshot(snapshot);
+    reference.saveSnapshot(again);
+    check(again.checksum() == snapshot.checksum(), name + ": save after restore changed the checksum");
+
+    // Rollback run - every few ticks go back and resimulate the last ones from their snapshots
+    Game game(options);
+    std::vector<GameSnapshot> history(HISTORY);
+    for (GameSnapshot& saved : history) {
+        game.prepareSnapshot(saved);
+    }
+    long long resimulated = 0;
+    int mismatches = 0;
+    int tick = 0;
+    while (tick < static_cast<int>(expected.size())) {
+        game.saveSnapshot(history[tick % HISTORY]);
+        game.step(actions[tick], partnerActions[tick]);
+        ++tick;
+
+        if (tick % ROLLBACK_EVERY == 0 && tick >= ROLLBACK_TICKS) {
+            int from = tick - ROLLBACK_TICKS;
+            game.restoreSnapshot(history[from % HISTORY]);
+            for (int replay = from; replay < tick; ++replay) {
+                game.saveSnapshot(history[replay % HISTORY]);
+                game.step(actions[replay], partnerActions[replay]);
+                ++resimulated;
+            }
+        }
+
+        game.saveSnapshot(snapshot);
+        if (snapshot.checksum() != expected[tick - 1] && mismatches++ == 0) {
+            check(false, name + ": checksum differs from the straight run at tick " + std::to_string(tick));
+        }
+    }
+
+    std::cout << name << ": " << expected.size() << " ticks, " << resimulated << " resimulated, "
+              << mismatches << " mismatches" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 6000;
+    std::uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 99;
+
+    checkRollback(false, ticks, seed);
+    checkRollback(true, ticks, seed);
+
+    std::cout << (failures == 0 ? "All snapshot checks passed" : "Snapshot checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
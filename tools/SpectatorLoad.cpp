@@ -0,0 +1,133 @@
+// Load test for SpectatorServer: one server publishing a moving test pattern to hundreds of
+// loopback spectators, some of which read far too slowly to keep up.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\SpectatorLoad.cpp SpectatorServer.cpp AnsiEncoder.cpp Frame.cpp Sprite.cpp ConsoleUtils.cpp
+// Usage: SpectatorLoad [spectators] [frames] [slow every nth] [port]
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "SpectatorServer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Client {
+    SOCKET socket;
+    bool slow;
+    std::size_t received;
+};
+
+// Connect a non-blocking spectator, shrinking its receive buffer so slow ones back up quickly
+static SOCKET connectSpectator(unsigned short port) {
+    SOCKET client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int bufferSize = 16 * 1024;
+    setsockopt(client, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) {
+        closesocket(client);
+        return INVALID_SOCKET;
+    }
+
+    u_long enabled = 1;
+    ioctlsocket(client, FIONBIO, &enabled);
+    return client;
+}
+
+// Read whatever is waiting, at most limit bytes
+static void drain(Client& client, std::size_t limit) {
+    char buffer[4096];
+    while (limit > 0) {
+        int received = recv(client.socket, buffer, static_cast<int>(std::min(limit, sizeof(buffer))), 0);
+        if (received <= 0) {
+            return;
+        }
+        client.received += received;
+        limit -= received;
+    }
+}
+
+// Test pattern - a drifting column of text over a slowly changing background
+static void drawPattern(Frame& frame, int step) {
+    frame.clear();
+    for (int y = 0; y < POLE_ROWS; ++y) {
+        frame.put((step + y) % POLE_COLS, y, '*', static_cast<COLORS>(1 + y % 15));
+        if ((y + step / 10) % 4 == 0) {
+            frame.putText(2, y, "SPECTATOR LOAD", WHITE);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int spectatorCount = argc > 1 ? std::atoi(argv[1]) : 300;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 600;
+    int slowEvery = std::max(1, argc > 3 ? std::atoi(argv[3]) : 10);
+    unsigned short port = static_cast<unsigned short>(argc > 4 ? std::atoi(argv[4]) : 7777);
+
+    SpectatorServer server(port);
+    if (!server.isListening()) {
+        std::cerr << "Cannot listen on port " << port << std::endl;
+        return 1;
+    }
+
+    std::vector<Client> clients;
+    for (int i = 0; i < spectatorCount; ++i) {
+        SOCKET socket = connectSpectator(port);
+        if (socket == INVALID_SOCKET) {
+            std::cerr << "Connect failed after " << i << " spectators" << std::endl;
+            break;
+        }
+        clients.push_back(Client{ socket, i % slowEvery == slowEvery - 1, 0 });
+    }
+
+    Frame frame;
+    double totalMicroseconds = 0;
+    double worstMicroseconds = 0;
+    for (int step = 0; step < frames; ++step) {
+        drawPattern(frame, step);
+
+        auto start = std::chrono::steady_clock::now();
+        server.publish(frame);
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        totalMicroseconds += microseconds;
+        worstMicroseconds = std::max(worstMicroseconds, microseconds);
+
+        // Fast spectators take everything, slow ones a trickle
+        for (auto& client : clients) {
+            drain(client, client.slow ? 256 : SIZE_MAX);
+        }
+    }
+
+    std::size_t fastBytes = 0;
+    std::size_t slowBytes = 0;
+    int slowCount = 0;
+    for (auto& client : clients) {
+        if (client.slow) {
+            slowBytes += client.received;
+            ++slowCount;
+        }
+        else {
+            fastBytes += client.received;
+        }
+        closesocket(client.socket);
+    }
+    int fastCount = static_cast<int>(clients.size()) - slowCount;
+
+    std::cout << "Spectators:        " << server.getSpectatorCount() << " (" << slowCount << " slow)\n";
+    std::cout << "Frames published:  " << server.getFramesPublished() << "\n";
+    std::cout << "Publish time:      " << totalMicroseconds / std::max(1, frames) << " us avg, " << worstMicroseconds << " us worst\n";
+    std::cout << "Bytes encoded:     " << server.getBytesEncoded() << "\n";
+    std::cout << "Bytes per fast:    " << (fastCount > 0 ? fastBytes / fastCount : 0) << "\n";
+    std::cout << "Bytes per slow:    " << (slowCount > 0 ? slowBytes / slowCount : 0) << "\n";
+    std::cout << "Keyframes sent:    " << server.getKeyframesSent() << "\n";
+    std::cout << "Backlog resyncs:   " << server.getResyncs() << std::endl;
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Checks that readers of the shared state ring never see a torn state: a publisher thread fills
+// slots as fast as it can, every field derived from the tick, while reader threads read the
+// newest tick and ticks just behind it. Every read that reports success must be one whole,
+// consistent tick; reads the publisher overwrote are allowed to fail, and must say so.
+// Only one ring can exist per session, so don't run it next to a game started with --share-state.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\StateRingCheck.cpp StatePublisher.cpp StateReader.cpp
+// Usage: StateRingCheck [ticks] [readers]
+// Exits with 1 if any check fails.
+
+#include "StatePublisher.h"
+#include "StateReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Fill a state so that every part of it says which tick it is
+static void fillState(SharedState& state, std::uint64_t tick) {
+    state.level = static_cast<std::int32_t>(tick % 1000);
+    state.score = static_cast<std::int32_t>(tick * 3);
+    state.lives = static_cast<std::int32_t>(tick % 7);
+    state.playerX = static_cast<std::int16_t>(tick % 180);
+    state.playerY = static_cast<std::int16_t>(tick % 90);
+    state.enemyCount = static_cast<std::uint32_t>(tick % SHARED_MAX_ENEMIES);
+    state.bulletCount = static_cast<std::uint32_t>(tick % SHARED_MAX_BULLETS);
+    state.enemyTotal = state.enemyCount;
+    state.bulletTotal = state.bulletCount;
+    for (SharedObject& enemy : state.enemies) {
+        enemy.x = static_cast<std::int16_t>(tick);
+        enemy.y = static_cast<std::int16_t>(tick >> 16);
+    }
+    std::memset(state.bullets, static_cast<int>(tick & 0xFF), sizeof(state.bullets));
+    std::memset(state.glyphs, static_cast<int>(tick & 0xFF), sizeof(state.glyphs));
+    std::memset(state.colors, static_cast<int>((tick >> 8) & 0xFF), sizeof(state.colors));
+}
+
+// Whether a state that was read is exactly what fillState wrote for its tick
+static bool isWhole(const SharedState& state) {
+    std::uint64_t tick = state.tick;
+    if (state.level != static_cast<std::int32_t>(tick % 1000) || state.score != static_cast<std::int32_t>(tick * 3) ||
+        state.lives != static_cast<std::int32_t>(tick % 7) || state.playerX != static_cast<std::int16_t>(tick % 180) ||
+        state.playerY != static_cast<std::int16_t>(tick % 90) ||
+        state.enemyCount != tick % SHARED_MAX_ENEMIES || state.bulletCount != tick % SHARED_MAX_BULLETS ||
+        state.enemyTotal != state.enemyCount || state.bulletTotal != state.bulletCount) {
+        return false;
+    }
+    for (const SharedObject& enemy : state.enemies) {
+        if (enemy.x != static_cast<std::int16_t>(tick) || enemy.y != static_cast<std::int16_t>(tick >> 16)) {
+            return false;
+        }
+    }
+    const std::uint8_t* bullets = reinterpret_cast<const std::uint8_t*>(state.bullets);
+    const std::uint8_t* glyphs = reinterpret_cast<const std::uint8_t*>(state.glyphs);
+    return std::all_of(bullets, bullets + sizeof(state.bullets), [&](std::uint8_t b) { return b == (tick & 0xFF); }) &&
+        std::all_of(glyphs, glyphs + sizeof(state.glyphs), [&](std::uint8_t g) { return g == (tick & 0xFF); }) &&
+        std::all_of(state.colors, state.colors + sizeof(state.colors), [&](std::uint8_t c) { return c == ((tick >> 8) & 0xFF); });
+}
+
+// What one reader thread saw
+struct ReaderResult {
+    long long whole = 0;
+    long long refused = 0;
+    long long torn = 0;
+    long long wrongTick = 0;
+};
+
+int main(int argc, char* argv[]) {
+    std::uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    int readerCount = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    StatePublisher publisher;
+    check(publisher.isOpen(), "could not create the ring");
+    if (!publisher.isOpen()) {
+        return 1;
+    }
+
+    std::atomic<bool> finished(false);
+    std::vector<ReaderResult> results(readerCount);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r] {
+            StateReader reader;
+            if (!reader.open()) {
+                return;
+            }
+            std::unique_ptr<SharedState> state(new SharedState());
+            ReaderResult& result = results[r];
+            std::uint64_t lag = 0;
+            while (!finished.load(std::memory_order_acquire)) {
+                // Alternate between the newest tick and ones the publisher is about to reuse
+                std::uint64_t count = reader.published();
+                if (count == 0) {
+                    continue;
+                }
+                lag = (lag + 1) % SHARED_STATE_SLOTS;
+                std::uint64_t tick = count - 1 - std::min(lag, count - 1);
+                if (!reader.read(tick, *state)) {
+                    ++result.refused;
+                }
+                else if (state->tick != tick) {
+                    ++result.wrongTick;
+                }
+                else if (!isWhole(*state)) {
+                    ++result.torn;
+                }
+                else {
+                    ++result.whole;
+                }
+            }
+        });
+    }
+
+    for (std::uint64_t tick = 0; tick < ticks; ++tick) {
+        fillState(publisher.begin(), tick);
+        publisher.commit();
+    }
+    finished.store(true, std::memory_order_release);
+    for (std::thread& thread : readers) {
+        thread.join();
+    }
+
+    // Once the publisher has stopped, every tick still in the ring reads back whole
+    StateReader reader;
+    check(reader.open(), "could not open the ring as a reader");
+    if (reader.isOpen()) {
+        check(reader.published() == ticks, "published count differs from the ticks written");
+        std::unique_ptr<SharedState> state(new SharedState());
+        for (std::uint64_t tick = ticks - std::min<std::uint64_t>(ticks, SHARED_STATE_SLOTS); tick < ticks; ++tick) {
+            check(reader.read(tick, *state) && isWhole(*state), "tick " + std::to_string(tick) + " does not read back whole");
+        }
+        check(ticks <= SHARED_STATE_SLOTS || !reader.read(ticks - SHARED_STATE_SLOTS - 1, *state),
+            "a tick that was overwritten still reads as valid");
+    }
+
+    for (int r = 0; r < readerCount; ++r) {
+        const ReaderResult& result = results[r];
+        std::cout << "reader " << r << ": " << result.whole << " whole, " << result.refused << " refused, "
+                  << result.torn << " torn, " << result.wrongTick << " wrong tick" << std::endl;
+        check(result.torn == 0 && result.wrongTick == 0, "reader " + std::to_string(r) + " accepted a torn or wrong state");
+        check(result.whole > 0, "reader " + std::to_string(r) + " never read a whole state");
+    }
+
+    std::cout << (failures == 0 ? "All state ring checks passed" : "State ring checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
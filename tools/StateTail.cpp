@@ -0,0 +1,74 @@
+// Tails the shared state ring of a game started with --share-state, printing one line per tick.
+// Build from the repository root, e.g.
+//   cl /std:c++20 /O2 /EHsc /I. tools\StateTail.cpp StateReader.cpp
+// Usage: StateTail [--frame]   (--frame also draws the newest frame once a second)
+
+#include "StateReader.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Print the glyphs of a frame as plain text
+static void printFrame(const SharedState& state) {
+    std::string line;
+    for (int y = 0; y < SHARED_STATE_ROWS; ++y) {
+        line.assign(state.glyphs + y * SHARED_STATE_COLS, SHARED_STATE_COLS);
+        line.erase(line.find_last_not_of(' ') + 1);
+        std::cout << line << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool showFrames = argc > 1 && std::strcmp(argv[1], "--frame") == 0;
+
+    StateReader reader;
+    while (!reader.open()) {
+        std::cerr << "Waiting for a game started with --share-state..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    // Too large for the stack
+    auto state = std::make_unique<SharedState>();
+    std::uint64_t next = reader.published();
+    std::uint64_t missed = 0;
+    auto lastFrame = std::chrono::steady_clock::now();
+
+    for (;;) {
+        std::uint64_t published = reader.published();
+
+        // The game restarted and began a new stream
+        if (published < next) {
+            next = published;
+        }
+
+        // Fell more than a ring behind - skip to the oldest tick still there
+        if (published - next > SHARED_STATE_SLOTS) {
+            missed += published - SHARED_STATE_SLOTS - next;
+            next = published - SHARED_STATE_SLOTS;
+        }
+
+        for (; next < published; ++next) {
+            if (!reader.read(next, *state)) {
+                ++missed;
+                continue;
+            }
+            std::cout << "tick " << state->tick << "  level " << state->level << "  score " << state->score
+                << "  lives " << state->lives << "  player " << state->playerX << ',' << state->playerY
+                << "  enemies " << state->enemyTotal << "  bullets " << state->bulletTotal
+                << "  missed " << missed << '\n';
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (showFrames && now - lastFrame >= std::chrono::seconds(1) && reader.readLatest(*state)) {
+            printFrame(*state);
+            lastFrame = now;
+        }
+
+        std::cout.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}